@@ -0,0 +1,33 @@
+/*
+ * Host stand-in for the Arduino core headers pulled in by Adafruit_GFX.h.
+ * Only what the GFX library actually touches is provided; build with
+ * -DARDUINO=100 so the GFX headers take the Arduino include path.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef bool boolean;
+
+#define PROGMEM                 // no separate flash address space here
+
+#include "Print.h"
+
+class __FlashStringHelper;
+
+class String
+{
+public:
+    String(const char *s = "") : _s(s) { }
+    unsigned int length(void) const { return strlen(_s); }
+    const char  *c_str(void) const { return _s; }
+private:
+    const char *_s;
+};
+
+#endif
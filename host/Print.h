@@ -0,0 +1,27 @@
+/*
+ * Host stand-in for the Arduino Print class (see Arduino.h).
+ */
+
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class Print
+{
+public:
+    virtual ~Print() { }
+    virtual size_t write(uint8_t) = 0;
+
+    size_t write(const char *str)
+    {
+        size_t n = 0;
+        while (*str) n += write((uint8_t)*str++);
+        return n;
+    }
+    size_t print(const char *str) { return write(str); }
+};
+
+#endif
@@ -0,0 +1,307 @@
+/*
+ * Model of an ST7735/ST7789 controller for host programs. It decodes the
+ * bytes the driver puts on the bus into a 240x320 GRAM, so what a drawing
+ * call actually produces on the glass can be compared pixel for pixel or
+ * written out as a PPM image, and it counts what the stream cost.
+ *
+ * Decoded: SWRESET, CASET, RASET, RAMWR, MADCTL (MX/MY/MV and BGR), COLMOD
+ * (12, 16 and 18 bits per pixel), INVON/INVOFF, VSCRDEF and VSCRSADD, and
+ * the ST7789's power modes: PTLAR/PTLON/NORON, IDMON/IDMOFF and FRCTRL1.
+ * Other commands are only counted.
+ *
+ * pixel() and shown() take GRAM coordinates. With MADCTL 0, as the driver
+ * uses in rotation 0, these are the address coordinates the driver sends,
+ * i.e. including the panel's column/row offsets; origin() gives those of
+ * the last window opened.
+ */
+
+#ifndef HOST_PANEL_H
+#define HOST_PANEL_H
+
+#include "mbed.h"
+
+struct HostPanelStats {
+    uint32_t commands;      // bytes sent with DC low
+    uint32_t dataBytes;     // bytes sent with DC high, parameters and pixels
+    uint32_t caset;         // CASET / RASET commands, i.e. window setups
+    uint32_t raset;
+    uint32_t ramwr;         // RAMWR commands
+    uint32_t pixels;        // pixels written to GRAM
+};
+
+class HostPanel
+{
+public:
+    enum { WIDTH = 240, HEIGHT = 320 };
+
+    // Start decoding the bus; 'dc' is the pin the driver uses for DC
+    void attach(PinName dc)
+    {
+        active() = this;
+        host_dc_pin   = dc;
+        host_spi_sink = sink;
+        reset();
+        resetStats();
+        clear(0);
+    }
+
+    void clear(uint16_t color)
+    {
+        for (int i = 0; i < WIDTH * HEIGHT; i++) _gram[i] = color;
+    }
+
+    uint16_t pixel(int x, int y) const { return _gram[y * WIDTH + x]; }
+
+    // What the glass shows on display line y, after vertical scrolling
+    uint16_t shown(int x, int y) const
+    {
+        if (_vsa && y >= _tfa && y < _tfa + _vsa) y = _tfa + (y - _tfa + _vsp - _tfa) % _vsa;
+        return pixel(x, y);
+    }
+    int      originX(void) const { return _xs; }
+    int      originY(void) const { return _ys; }
+
+    // IPS glass, like the 135x240 module's, shows GRAM as written only
+    // while INVON is in effect; set false for a TN panel
+    void     setIPS(bool ips) { _ips = ips; }
+
+    bool     partial(void) const { return _partial; }
+    bool     idle(void) const { return _idle; }
+
+    // Refresh rate: 60Hz at FRCTRL2's default, divided by FRCTRL1 in
+    // partial and idle mode once FRSEN is set
+    int      frameRateHz(void) const
+    {
+        if ((_partial || _idle) && (_frctrl1 & 0x10)) return 60 >> (_frctrl1 & 0x03);
+        return 60;
+    }
+
+    const HostPanelStats &stats(void) const { return _stats; }
+    void     resetStats(void) { memset(&_stats, 0, sizeof(_stats)); }
+
+    // Time the counted bytes spend on the wire at the given SPI clock,
+    // without any per-call overhead
+    uint64_t busNs(uint32_t hz) const
+    {
+        return (uint64_t)(_stats.commands + _stats.dataBytes) * 8 * 1000000000ULL / hz;
+    }
+
+    // Write the w x h pixels at (x,y) as shown, including scrolling,
+    // inversion, colour order, the rows partial mode leaves undriven
+    // (black) and idle mode's 8 colours, as a binary PPM. w or h 0 means to
+    // the edge of GRAM.
+    bool writePPM(const char *path, int x = 0, int y = 0, int w = 0, int h = 0) const
+    {
+        FILE *f = fopen(path, "wb");
+
+        if (!f) return false;
+        if (w <= 0) w = WIDTH - x;
+        if (h <= 0) h = HEIGHT - y;
+        fprintf(f, "P6\n%d %d\n255\n", w, h);
+        for (int j = y; j < y + h; j++) {
+            for (int i = x; i < x + w; i++) {
+                uint16_t c = shown(i, j);
+                uint8_t  rgb[3];
+
+                if (_inverted != _ips) c = ~c;
+                if (_partial && (j < _ptlSr || j > _ptlEr)) c = _ips ? 0x0000 : 0xFFFF;
+                if (_idle) c = (c & 0x8000 ? 0xF800 : 0) | (c & 0x0400 ? 0x07E0 : 0) | (c & 0x0010 ? 0x001F : 0);
+                rgb[0] = (c >> 8 & 0xF8) | c >> 13;
+                rgb[1] = (c >> 3 & 0xFC) | (c >> 9 & 0x03);
+                rgb[2] = (c << 3 & 0xF8) | (c >> 2 & 0x07);
+                if (_madctl & 0x08) {           // BGR panel order
+                    uint8_t t = rgb[0];
+                    rgb[0] = rgb[2];
+                    rgb[2] = t;
+                }
+                fwrite(rgb, 1, 3, f);
+            }
+        }
+        return fclose(f) == 0;
+    }
+
+private:
+    static HostPanel *&active(void)
+    {
+        static HostPanel *panel;
+        return panel;
+    }
+
+    static void sink(int dc, const uint8_t *data, int len)
+    {
+        for (int i = 0; i < len; i++) active()->feed(dc, data[i]);
+    }
+
+    // Power-on / SWRESET register values
+    void reset(void)
+    {
+        _cmd = 0;
+        _argc = 0;
+        _xs = _ys = 0;
+        _xe = WIDTH - 1;
+        _ye = HEIGHT - 1;
+        _madctl = 0;
+        _colmod = 0x66;
+        _inverted = false;
+        _tfa = _vsa = _vsp = 0;
+        _partial = _idle = false;
+        _ptlSr = 0;
+        _ptlEr = HEIGHT - 1;
+        _frctrl1 = 0;
+    }
+
+    // Store one pixel at the current address and advance it. MX and MY
+    // mirror the column and row address, MV exchanges them.
+    void put(uint16_t color)
+    {
+        int c = _x, r = _y;
+
+        if (_madctl & 0x40) c = (_madctl & 0x20 ? HEIGHT : WIDTH) - 1 - c;
+        if (_madctl & 0x80) r = (_madctl & 0x20 ? WIDTH : HEIGHT) - 1 - r;
+        if (_madctl & 0x20) {
+            int t = c;
+            c = r;
+            r = t;
+        }
+        if (c >= 0 && c < WIDTH && r >= 0 && r < HEIGHT) _gram[r * WIDTH + c] = color;
+        _stats.pixels++;
+        if (++_x > _xe) {
+            _x = _xs;
+            if (++_y > _ye) _y = _ys;
+        }
+    }
+
+    // RAMWR data in the current COLMOD interface format
+    void ramData(uint8_t b)
+    {
+        _acc[_accN++] = b;
+        switch (_colmod & 0x07) {
+        case 0x03:                  // 12 bits: R1G1 B1R2 G2B2
+            if (_accN == 2) {
+                put(rgb444((_acc[0] << 4) | (_acc[1] >> 4)));
+            } else if (_accN == 3) {
+                put(rgb444(((_acc[1] & 0x0F) << 8) | _acc[2]));
+                _accN = 0;
+            }
+            break;
+        case 0x05:                  // 16 bits, RGB565 big endian
+            if (_accN == 2) {
+                put((_acc[0] << 8) | _acc[1]);
+                _accN = 0;
+            }
+            break;
+        default:                    // 18 bits, one byte per component
+            if (_accN == 3) {
+                put((_acc[0] & 0xF8) << 8 | (_acc[1] & 0xFC) << 3 | _acc[2] >> 3);
+                _accN = 0;
+            }
+            break;
+        }
+    }
+
+    // The controller widens 4-bit components by repeating their top bits
+    static uint16_t rgb444(uint16_t c)
+    {
+        uint16_t r = c >> 8 & 0x0F, g = c >> 4 & 0x0F, b = c & 0x0F;
+
+        return (r << 12 | r >> 3 << 11) | (g << 7 | g >> 2 << 5) | (b << 1 | b >> 3);
+    }
+
+    void feed(int dc, uint8_t b)
+    {
+        if (!dc) {
+            _stats.commands++;
+            _cmd  = b;
+            _argc = 0;
+            switch (_cmd) {
+            case 0x01:              // SWRESET
+                reset();
+                break;
+            case 0x12:              // PTLON
+            case 0x13:              // NORON
+                _partial = _cmd == 0x12;
+                break;
+            case 0x38:              // IDMOFF
+            case 0x39:              // IDMON
+                _idle = _cmd == 0x39;
+                break;
+            case 0x20:              // INVOFF
+            case 0x21:              // INVON
+                _inverted = _cmd == 0x21;
+                break;
+            case 0x2A:
+                _stats.caset++;
+                break;
+            case 0x2B:
+                _stats.raset++;
+                break;
+            case 0x2C:              // RAMWR
+                _stats.ramwr++;
+                _x = _xs;
+                _y = _ys;
+                _accN = 0;
+                break;
+            }
+            return;
+        }
+        _stats.dataBytes++;
+        if (_cmd == 0x2C) {
+            ramData(b);
+            return;
+        }
+        if (_argc < 6) _args[_argc] = b;
+        _argc++;
+        switch (_cmd) {
+        case 0x2A:                  // CASET
+            if (_argc == 4) {
+                _xs = (_args[0] << 8) | _args[1];
+                _xe = (_args[2] << 8) | _args[3];
+            }
+            break;
+        case 0x2B:                  // RASET
+            if (_argc == 4) {
+                _ys = (_args[0] << 8) | _args[1];
+                _ye = (_args[2] << 8) | _args[3];
+            }
+            break;
+        case 0x30:                  // PTLAR
+            if (_argc == 4) {
+                _ptlSr = (_args[0] << 8) | _args[1];
+                _ptlEr = (_args[2] << 8) | _args[3];
+            }
+            break;
+        case 0x33:                  // VSCRDEF
+            if (_argc == 6) {
+                _tfa = (_args[0] << 8) | _args[1];
+                _vsa = (_args[2] << 8) | _args[3];
+            }
+            break;
+        case 0x36:                  // MADCTL
+            if (_argc == 1) _madctl = b;
+            break;
+        case 0x37:                  // VSCRSADD
+            if (_argc == 2) _vsp = (_args[0] << 8) | _args[1];
+            break;
+        case 0x3A:                  // COLMOD
+            if (_argc == 1) _colmod = b;
+            break;
+        case 0xB3:                  // FRCTRL1
+            if (_argc == 1) _frctrl1 = b;
+            break;
+        }
+    }
+
+    uint16_t _gram[WIDTH * HEIGHT];
+    uint8_t  _cmd, _args[6], _acc[3];
+    uint32_t _argc, _accN;
+    int      _xs, _xe, _ys, _ye, _x, _y;
+    uint8_t  _madctl, _colmod;
+    bool     _inverted, _ips = true;
+    int      _tfa, _vsa, _vsp;
+    bool     _partial, _idle;
+    int      _ptlSr, _ptlEr;
+    uint8_t  _frctrl1;
+    HostPanelStats _stats;
+};
+
+#endif
@@ -0,0 +1,39 @@
+/*
+ * LVGL configuration for host/lvgl_check.cpp: the application's own
+ * lib/lv_conf.h, found through -Ihost ahead of -Ilib, with the options the
+ * check covers beyond the application's defaults.
+ */
+
+#ifndef HOST_LV_CONF_H
+#define HOST_LV_CONF_H
+
+#include "../lib/lv_conf.h"
+
+/* The check steps the tick itself with lv_tick_inc() */
+#undef  LV_TICK_CUSTOM
+#define LV_TICK_CUSTOM          0
+
+/* Off in the application for its RAM cost */
+#undef  LV_USE_COL_DELTA
+#define LV_USE_COL_DELTA        1
+#define LV_COL_DELTA_W          16
+#define LV_COL_DELTA_WIN_COST   32
+
+/* Profiles timed with the C library's CPU clock */
+#undef  LV_USE_PROF
+#define LV_USE_PROF             1
+#define LV_PROF_FRAMES          8
+#define LV_PROF_TYPES           8
+#define LV_PROF_TIME_INCLUDE    <time.h>
+#define LV_PROF_TIME_EXPR       ((uint32_t)((uint64_t)clock() * 1000000 / CLOCKS_PER_SEC))
+
+/* -DHOST_LV_INV_TILES=1 on both compilers checks the dirty-tile bitmap */
+#ifdef HOST_LV_INV_TILES
+#undef  LV_INV_TILES
+#define LV_INV_TILES            HOST_LV_INV_TILES
+#ifndef LV_INV_TILE_SIZE
+#define LV_INV_TILE_SIZE        16
+#endif
+#endif
+
+#endif /*HOST_LV_CONF_H*/
@@ -0,0 +1,720 @@
+/*
+ * Host check of the LVGL refresh path as src/main.cpp sets it up: a 135x240
+ * screen rendered in two 10-row buffers, flushed through Adafruit_ST7735
+ * and decoded back by host/host_panel.h. Every case changes a screen in
+ * ways the refresh takes shortcuts on, then redraws the whole screen the
+ * plain way, in one strip with nothing cached from earlier flushes; the
+ * panel must show the same pixels both times. Cases also check that the
+ * shortcut saved something.
+ *
+ * The scroll case scrolls a page in 13 steps, first with the display's
+ * scroll_cb removed and then in hardware, which must flush under half the
+ * pixels.
+ *
+ * The join case recolours 20 small squares along a row at once, joining
+ * the invalidated areas at the cost main.cpp sets per strip and at no
+ * cost; the per-strip cost must leave fewer areas. The overflow case
+ * recolours 60 points of a curve, more areas than LV_INV_BUF_SIZE, which
+ * must still be refreshed as far fewer pixels than the screen.
+ *
+ * The drawlist case redraws a screen of widgets, which must be recorded
+ * in the draw list once and replayed for every strip, and then an object
+ * whose design puts pixels with lv_draw_px() down several strips, which
+ * can't be recorded and must be drawn the usual way.
+ *
+ * The occlusion case redraws a full-screen page holding three opaque
+ * cards, which must cull what the cards cover; the reference redraw has
+ * the cards deny covering anything, so nothing is culled there.
+ *
+ * The hash case invalidates a screen again after a full redraw, which
+ * must flush no strip, and changes a label there and back before
+ * invalidating the screen again, which must flush only some strips.
+ *
+ * The coldelta case changes one end of a row of text, which must flush
+ * fewer bytes than the strips it is in, then makes random changes to a
+ * screen for 300 frames with one and with two buffers; each run must
+ * match the reference.
+ *
+ * The pacing case runs lv_task_handler() the way main.cpp's loop does,
+ * sleeping until the next task is due. An idle second must take at most
+ * two handler calls, a change after idling must call wake_cb once and be
+ * drawn on the next call, frames that overrun the refresh period must
+ * lengthen it, and it must come back to LV_REFR_MIN_PERIOD once they are
+ * fast again.
+ *
+ * The prof case moves a slider in 12 frames; the profiler must keep the
+ * last LV_PROF_FRAMES of them, not a refresh which drew nothing, with the
+ * flushes and bytes flush_cb really got and the slider's design time.
+ *
+ * host/lv_conf.h adds options to lib/lv_conf.h. Building with
+ * -DHOST_LV_INV_TILES=1 on both compilers keeps invalidated areas as
+ * dirty tiles; the overflow case must then not overflow, while the join
+ * and scroll cases only compare pixels, as the bitmap merges the squares
+ * and hardware scrolling is declined.
+ *
+ * Build and run from the repository root:
+ *
+ *   mkdir -p lvobj
+ *   for f in $(find lib/lvgl/src -name '*.c'); do
+ *       gcc -O2 -DLV_CONF_INCLUDE_SIMPLE -Ihost -Ilib -Ilib/lvgl \
+ *           -c $f -o lvobj/$(basename $f .c).o
+ *   done
+ *   g++ -O2 -DARDUINO=100 -DLV_CONF_INCLUDE_SIMPLE -Ihost -Ilib -Ilib/lvgl \
+ *       -Ilib/Adafruit_ST7735_ID2150 "-Ilib/Adafruit GFX Library_ID13" \
+ *       host/lvgl_check.cpp host/mbed.cpp \
+ *       lib/Adafruit_ST7735_ID2150/Adafruit_ST7735.cpp \
+ *       "lib/Adafruit GFX Library_ID13/Adafruit_GFX.cpp" lvobj/lv_*.o \
+ *       -o lvgl_check
+ *   ./lvgl_check [cases]
+ *
+ * Exits non-zero and names the first differing pixel on a mismatch.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mbed.h"
+#include "host_panel.h"
+#include "Adafruit_ST7735.h"
+#include "lvgl.h"
+
+#define W       135
+#define H       240
+
+static HostPanel       panel;
+static Adafruit_ST7735 tft(0, 1, 2, 3, 4, 5);
+static int             ox, oy;            // controller position of pixel (0,0)
+
+static lv_disp_t      *disp;
+static lv_disp_buf_t   strips;            // the two 10-row buffers main.cpp uses
+static lv_disp_buf_t   whole;             // one strip for the reference redraw
+static uint32_t        flushes, flushed;  // flush_cb calls and pixels in the last frame()
+static uint32_t        flush_ms;          // ticks each flush takes in the pacing case
+
+static void disp_flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    uint32_t size = lv_area_get_size(area);
+
+    flushes++;
+    flushed += size;
+    tft.setAddrWindow(area->x1, area->y1, area->x2, area->y2);
+    tft.pushBytes((const uint8_t *)color_p, size * sizeof(lv_color_t));
+    lv_tick_inc(flush_ms);
+    lv_disp_flush_ready(drv);
+}
+
+static bool disp_scroll(lv_disp_drv_t * /*drv*/, const lv_area_t *area, lv_coord_t dy)
+{
+    if (area == NULL) return tft.setScrollArea(0, 0);
+    if (!tft.setScrollArea(area->y1, area->y2 - area->y1 + 1)) return false;
+    tft.scroll(dy);
+    return true;
+}
+
+static void setup(void)
+{
+    static lv_color_t buf1[W * 10], buf2[W * 10], full[W * H];
+
+    panel.attach(4);
+    tft.initST7789();
+    tft.fillScreen(0);
+    ox = panel.originX();
+    oy = panel.originY();
+
+    lv_init();
+    lv_disp_buf_init(&strips, buf1, buf2, W * 10);
+    lv_disp_buf_init(&whole, full, NULL, W * H);
+
+    lv_disp_drv_t drv;
+    lv_disp_drv_init(&drv);
+    drv.hor_res   = W;
+    drv.ver_res   = H;
+    drv.flush_cb  = disp_flush;
+    drv.area_cost = 50;
+    drv.scroll_cb = disp_scroll;
+    drv.buffer    = &strips;
+    disp = lv_disp_drv_register(&drv);
+}
+
+// Refresh what has been invalidated since the last frame
+static void frame(void)
+{
+    flushes = flushed = 0;
+    lv_tick_inc(40);
+    lv_refr_now(disp);
+}
+
+// Start a case on an empty screen, dropping the last case's objects
+static lv_obj_t *screen(void)
+{
+    lv_obj_t *old = lv_disp_get_scr_act(disp);
+    lv_obj_t *scr = lv_obj_create(NULL, NULL);
+
+    lv_disp_load_scr(scr);
+    lv_obj_del(old);
+    frame();
+    return scr;
+}
+
+// Redraw the screen in one strip with nothing cached, unscrolled, and
+// compare it with what the panel showed before
+static bool same(const char *name)
+{
+    static uint16_t shown[W * H];
+
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) shown[y * W + x] = panel.shown(x + ox, y + oy);
+    }
+
+    tft.setScrollArea(0, 0);
+    lv_area_set(&disp->hw_scroll_band, 0, 0, -1, -1);
+#if LV_USE_STRIP_HASH
+    lv_disp_clean_strip_hash(disp);
+#endif
+#if LV_USE_COL_DELTA
+    lv_disp_clean_col_sig(disp);
+#endif
+    panel.clear(0);
+    disp->driver.buffer = &whole;
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    frame();
+    disp->driver.buffer = &strips;
+
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            uint16_t got  = shown[y * W + x];
+            uint16_t want = panel.shown(x + ox, y + oy);
+            if (got != want) {
+                printf("%s: pixel (%d,%d) is %04x, expected %04x\n", name, x, y, got, want);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// A page of 40 labels scrolled in steps of both signs and various sizes;
+// returns the pixels flushed for the steps
+static uint32_t scrollSteps(bool hw)
+{
+    static const int steps[] = { -3, -3, -5, -8, -13, -1, 7, 4, -20, -30, 2, -60, 15 };
+    static lv_style_t bg;
+    uint32_t total = 0;
+
+    lv_obj_t *scr = screen();
+    disp->driver.scroll_cb = hw ? disp_scroll : NULL;
+
+    lv_style_copy(&bg, &lv_style_plain);
+    bg.body.main_color = bg.body.grad_color = LV_COLOR_NAVY;
+    bg.body.border.color  = LV_COLOR_RED;
+    bg.body.border.width  = 2;
+    bg.body.radius        = 4;
+    bg.body.padding.left  = bg.body.padding.right = 6;
+    bg.body.padding.top   = bg.body.padding.bottom = 6;
+
+    lv_obj_t *title = lv_label_create(scr, NULL);
+    lv_label_set_text(title, "Title");
+
+    lv_obj_t *page = lv_page_create(scr, NULL);
+    lv_page_set_style(page, LV_PAGE_STYLE_BG, &bg);
+    lv_obj_set_size(page, W, 200);
+    lv_obj_set_pos(page, 0, 30);
+    lv_page_set_sb_mode(page, LV_SB_MODE_ON);
+    for (int i = 0; i < 40; i++) {
+        char t[16];
+        snprintf(t, sizeof(t), "Item %d abcdef", i);
+        lv_obj_t *l = lv_label_create(page, NULL);
+        lv_label_set_text(l, t);
+        lv_obj_set_pos(l, 4 + (i % 5) * 3, i * 22);
+    }
+    frame();
+
+    lv_obj_t *scrl = lv_page_get_scrl(page);
+    for (unsigned s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        lv_obj_set_y(scrl, lv_obj_get_y(scrl) + steps[s]);
+        frame();
+        total += flushed;
+    }
+    disp->driver.scroll_cb = disp_scroll;
+    return total;
+}
+
+static bool scroll(void)
+{
+    uint32_t redrawn = scrollSteps(false);
+    if (!same("scroll redrawn")) return false;
+
+    uint32_t moved = scrollSteps(true);
+    if (!same("scroll in hardware")) return false;
+
+    printf("%-12s %u px flushed in hardware, %u redrawn\n", "scroll", (unsigned)moved, (unsigned)redrawn);
+#if LV_INV_TILES
+    return true;                    // lv_refr_hw_scroll() declines with tiles
+#else
+    return moved < redrawn / 2;
+#endif
+}
+
+// 20 squares along a row, all recoloured for each area cost
+static bool join(void)
+{
+    static const uint32_t costs[] = { 50, 0 };
+    static lv_style_t sq[2];
+    lv_obj_t *o[20];
+    uint16_t before[2], after[2];
+
+    lv_obj_t *scr = screen();
+    for (int k = 0; k < 2; k++) {
+        lv_style_copy(&sq[k], &lv_style_plain);
+        sq[k].body.main_color = sq[k].body.grad_color = k ? LV_COLOR_RED : LV_COLOR_GREEN;
+    }
+    for (int i = 0; i < 20; i++) {
+        o[i] = lv_obj_create(scr, NULL);
+        lv_obj_set_style(o[i], &sq[0]);
+        lv_obj_set_pos(o[i], 2 + i * 6, 52);
+        lv_obj_set_size(o[i], 4, 4);
+    }
+    frame();
+
+    for (int c = 0; c < 2; c++) {
+        disp->driver.area_cost = costs[c];
+        for (int i = 0; i < 20; i++) lv_obj_set_style(o[i], &sq[!c]);
+        frame();
+        before[c] = disp->inv_p_before_join;
+        after[c]  = disp->inv_p_after_join;
+    }
+    disp->driver.area_cost = 50;
+    if (!same("join")) return false;
+
+    printf("%-12s %u areas -> %u at cost 50, %u areas -> %u at cost 0\n", "join",
+           before[0], after[0], before[1], after[1]);
+#if LV_INV_TILES
+    return true;                    // the bitmap merges them before the join
+#else
+    return before[0] == 20 && after[0] < after[1];
+#endif
+}
+
+// 60 points of a curve recoloured at once, as a chart update would
+static bool overflow(void)
+{
+    static lv_style_t pt[2];
+    lv_obj_t *o[60];
+
+    lv_obj_t *scr = screen();
+    for (int k = 0; k < 2; k++) {
+        lv_style_copy(&pt[k], &lv_style_plain);
+        pt[k].body.main_color = pt[k].body.grad_color = k ? LV_COLOR_RED : LV_COLOR_BLUE;
+    }
+    for (int i = 0; i < 60; i++) {
+        o[i] = lv_obj_create(scr, NULL);
+        lv_obj_set_style(o[i], &pt[0]);
+        lv_obj_set_pos(o[i], i * 2, 120 + (int)(80 * sin(i / 6.0)) - 2);
+        lv_obj_set_size(o[i], 4, 5);
+    }
+    frame();
+
+    uint32_t overflows = disp->inv_overflows;
+    for (int i = 0; i < 60; i++) lv_obj_set_style(o[i], &pt[1]);
+    frame();
+    overflows = disp->inv_overflows - overflows;
+    uint32_t px = flushed, n = flushes;
+    unsigned areas = disp->inv_p_after_join;
+    if (!same("overflow")) return false;
+
+    printf("%-12s %u px in %u areas, %u flushes, %u overflows\n", "overflow", (unsigned)px, areas,
+           (unsigned)n, (unsigned)overflows);
+#if LV_INV_TILES
+    return overflows == 0 && px < W * H / 3;
+#else
+    return overflows > 0 && px < W * H / 3;
+#endif
+}
+
+#if LV_USE_DRAW_LIST
+static lv_design_cb_t ancestor_design;
+
+// A plain object with a diagonal of single pixels on it
+static bool dotsDesign(lv_obj_t *obj, const lv_area_t *mask, lv_design_mode_t mode)
+{
+    bool ret = ancestor_design(obj, mask, mode);
+
+    if (mode == LV_DESIGN_DRAW_MAIN) {
+        lv_area_t c;
+        lv_obj_get_coords(obj, &c);
+        for (lv_coord_t i = 0; i < lv_area_get_height(&c); i++) {
+            lv_draw_px(c.x1 + i % lv_area_get_width(&c), c.y1 + i, mask, LV_COLOR_RED, LV_OPA_COVER);
+        }
+    }
+    return ret;
+}
+
+static bool drawList(void)
+{
+    lv_obj_t *scr = screen();
+
+    lv_obj_t *l = lv_label_create(scr, NULL);
+    lv_label_set_long_mode(l, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(l, 130);
+    lv_label_set_text(l, "A label broken into lines which cross the strips");
+    lv_obj_t *btn = lv_btn_create(scr, NULL);
+    lv_obj_set_pos(btn, 10, 60);
+    lv_obj_set_size(btn, 100, 40);
+    lv_label_set_text(lv_label_create(btn, NULL), LV_SYMBOL_OK " OK");
+    lv_obj_t *sl = lv_slider_create(scr, NULL);
+    lv_obj_set_pos(sl, 10, 120);
+    lv_obj_set_size(sl, 110, 15);
+    lv_slider_set_value(sl, 40, LV_ANIM_OFF);
+    lv_obj_t *sw = lv_sw_create(scr, NULL);
+    lv_obj_set_pos(sw, 30, 160);
+    frame();
+
+    lv_obj_invalidate(scr);
+    frame();
+    unsigned ops = lv_draw_list_get_op_cnt();
+    if (!same("drawlist")) return false;
+
+    lv_obj_t *dots = lv_obj_create(scr, NULL);
+    ancestor_design = lv_obj_get_design_cb(dots);
+    lv_obj_set_design_cb(dots, dotsDesign);
+    lv_obj_set_pos(dots, 20, 170);
+    lv_obj_set_size(dots, 40, 60);
+    frame();
+    unsigned dotOps = lv_draw_list_get_op_cnt();
+    if (!same("drawlist lv_draw_px")) return false;
+
+    printf("%-12s %u operations for the screen, %u with lv_draw_px()\n", "drawlist", ops, dotOps);
+    return ops > 0 && dotOps == 0;
+}
+#endif
+
+#if LV_USE_OCCLUSION
+static lv_design_cb_t card_design;
+
+// The card's design, except that it never covers its area
+static bool uncoveredDesign(lv_obj_t *obj, const lv_area_t *mask, lv_design_mode_t mode)
+{
+    if (mode == LV_DESIGN_COVER_CHK) return false;
+    return card_design(obj, mask, mode);
+}
+
+static bool occlusion(void)
+{
+    static lv_style_t card;
+    static const char *texts[] = { "12:34", "Steps 4521", "Heart 72" };
+    lv_obj_t *cards[3];
+
+    lv_obj_t *scr = screen();
+    lv_style_copy(&card, &lv_style_plain);
+    card.body.main_color = LV_COLOR_NAVY;
+    card.body.grad_color = LV_COLOR_BLUE;
+    card.body.radius     = 6;
+    card.text.color      = LV_COLOR_WHITE;
+
+    lv_obj_t *page = lv_page_create(scr, NULL);
+    lv_obj_set_size(page, W, H);
+    lv_page_set_style(page, LV_PAGE_STYLE_BG, &lv_style_plain);
+    lv_page_set_style(page, LV_PAGE_STYLE_SCRL, &lv_style_transp);
+    for (int i = 0; i < 3; i++) {
+        cards[i] = lv_cont_create(page, NULL);
+        lv_cont_set_style(cards[i], LV_CONT_STYLE_MAIN, &card);
+        lv_obj_set_pos(cards[i], 4, 4 + i * 78);
+        lv_obj_set_size(cards[i], 127, 74);
+        lv_obj_t *t = lv_label_create(cards[i], NULL);
+        lv_label_set_text(t, texts[i]);
+        lv_obj_set_pos(t, 8, 8);
+    }
+    frame();
+
+    lv_obj_invalidate(scr);
+    frame();
+    uint32_t drawn = disp->px_drawn, culled = disp->px_culled;
+
+    card_design = lv_obj_get_design_cb(cards[0]);
+    for (int i = 0; i < 3; i++) lv_obj_set_design_cb(cards[i], uncoveredDesign);
+    if (!same("occlusion")) return false;
+
+    printf("%-12s %u px drawn, %u culled; %u drawn without culling\n", "occlusion", (unsigned)drawn,
+           (unsigned)culled, (unsigned)disp->px_drawn);
+    return culled > 0 && disp->px_culled == 0;
+}
+#endif
+
+#if LV_USE_STRIP_HASH
+static bool hash(void)
+{
+    lv_obj_t *scr = screen();
+
+    lv_obj_t *l = lv_label_create(scr, NULL);
+    lv_label_set_text(l, "12:34");
+    lv_obj_set_pos(l, 40, 100);
+    lv_obj_t *b = lv_bar_create(scr, NULL);
+    lv_obj_set_pos(b, 5, 200);
+    lv_obj_set_size(b, 125, 20);
+    lv_bar_set_value(b, 30, LV_ANIM_OFF);
+    frame();
+    lv_obj_invalidate(scr);
+    frame();
+
+    uint32_t skipped = disp->strips_skipped;
+    lv_obj_invalidate(scr);
+    frame();
+    uint32_t unchanged = disp->strips_skipped - skipped, unchangedFlushes = flushes;
+
+    lv_label_set_text(l, "12:35");
+    frame();
+    lv_label_set_text(l, "12:34");
+    skipped = disp->strips_skipped;
+    lv_obj_invalidate(scr);
+    frame();
+    uint32_t reverted = disp->strips_skipped - skipped, revertedFlushes = flushes;
+    if (!same("hash")) return false;
+
+    printf("%-12s screen again: %u strips skipped, %u flushes; label reverted: %u skipped, %u flushes\n",
+           "hash", (unsigned)unchanged, (unsigned)unchangedFlushes, (unsigned)reverted, (unsigned)revertedFlushes);
+    return unchanged == H / 10 && unchangedFlushes == 0 && reverted > 0 && revertedFlushes > 0;
+}
+#endif
+
+#if LV_USE_COL_DELTA
+// 300 frames of random changes to digits, a switch and label positions
+static bool randomFrames(lv_disp_buf_t *buf, const char *name)
+{
+    lv_obj_t *l[6];
+
+    lv_obj_t *scr = screen();
+    disp->driver.buffer = buf;
+    for (int i = 0; i < 6; i++) {
+        l[i] = lv_label_create(scr, NULL);
+        lv_label_set_text(l[i], "0");
+        lv_obj_set_pos(l[i], 5 + i * 21, 20 + (i % 3) * 60);
+    }
+    lv_obj_t *sw = lv_sw_create(scr, NULL);
+    lv_obj_set_pos(sw, 30, 200);
+    frame();
+
+    for (int f = 0; f < 300; f++) {
+        for (int n = rand() % 3; n >= 0; n--) {
+            char t[8];
+            snprintf(t, sizeof(t), "%d", rand() % 100);
+            lv_label_set_text(l[rand() % 6], t);
+        }
+        if (rand() % 7 == 0) lv_sw_toggle(sw, LV_ANIM_OFF);
+        if (rand() % 11 == 0) lv_obj_set_x(l[rand() % 6], rand() % 120);
+        frame();
+    }
+    disp->driver.buffer = &strips;
+    return same(name);
+}
+
+static bool colDelta(void)
+{
+    static lv_color_t single[W * 10];
+    static lv_disp_buf_t one;
+
+    lv_obj_t *scr = screen();
+    lv_obj_t *row = lv_label_create(scr, NULL);
+    lv_label_set_text(row, "A         B");
+    lv_obj_set_pos(row, 2, 100);
+    frame();
+
+    uint32_t skipped = disp->bytes_skipped;
+    lv_label_set_text(row, "A         C");
+    frame();
+    uint32_t sent = flushed * sizeof(lv_color_t);
+    skipped = disp->bytes_skipped - skipped;
+    if (!same("coldelta row")) return false;
+
+    lv_disp_buf_init(&one, single, NULL, W * 10);
+    if (!randomFrames(&one, "coldelta one buffer")) return false;
+    if (!randomFrames(&strips, "coldelta two buffers")) return false;
+
+    printf("%-12s one end of a row: %u of %u bytes flushed; 300 random frames match\n", "coldelta",
+           (unsigned)sent, (unsigned)(sent + skipped));
+    return skipped > 0;
+}
+#endif
+
+#if LV_USE_REFR_PACING
+static uint32_t frames, wakeups, wakes;
+
+static void monitor(lv_disp_drv_t * /*drv*/, uint32_t /*time*/, uint32_t /*px*/)
+{
+    frames++;
+}
+
+static void wake(lv_disp_drv_t * /*drv*/)
+{
+    wakes++;
+}
+
+// Call lv_task_handler() for `ms` ticks, sleeping in between until the next
+// task is due, as main.cpp's loop does
+static void run(uint32_t ms)
+{
+    while (ms > 0) {
+        lv_task_handler();
+        wakeups++;
+        uint32_t s = lv_task_get_time_till_next();
+        s = LV_MATH_MAX(LV_MATH_MIN(s, ms), 1);
+        lv_tick_inc(s);
+        ms -= s;
+    }
+}
+
+// Run until the next frame has been drawn; returns the ticks it took
+static uint32_t nextFrame(void)
+{
+    uint32_t f = frames, t = lv_tick_get();
+    while (frames == f) run(1);
+    return lv_tick_elaps(t) - 1;
+}
+
+static bool pacing(void)
+{
+    static lv_style_t bg[2];
+
+    lv_obj_t *scr = screen();
+    lv_obj_t *l = lv_label_create(scr, NULL);
+    lv_label_set_text(l, "12:34");
+    disp->driver.monitor_cb = monitor;
+    disp->driver.wake_cb    = wake;
+
+    run(100);
+    wakeups = frames = 0;
+    run(1000);
+    uint32_t idle = wakeups;
+
+    uint32_t worst = 0, woken = 0;
+    for (int i = 0; i < 20; i++) {
+        run(rand() % 97 + 30);
+        wakes = 0;
+        lv_label_set_text(l, i & 1 ? "12:35" : "12:36");
+        if (wakes == 1) woken++;
+        uint32_t t = nextFrame();
+        if (t > worst) worst = t;
+    }
+
+    // Whole-screen frames of 24 strips, 5 ticks each
+    for (int k = 0; k < 2; k++) {
+        lv_style_copy(&bg[k], &lv_style_scr);
+        bg[k].body.main_color = bg[k].body.grad_color = k ? LV_COLOR_BLUE : LV_COLOR_RED;
+    }
+    flush_ms = 5;
+    for (int i = 0; i < 6; i++) {
+        lv_obj_set_style(scr, &bg[i & 1]);
+        nextFrame();
+    }
+    uint16_t slow = disp->refr_period;
+    flush_ms = 0;
+    for (int i = 0; i < 10; i++) {
+        lv_label_set_text(l, i & 1 ? "C" : "D");
+        nextFrame();
+    }
+    uint16_t fast = disp->refr_period;
+    disp->driver.monitor_cb = NULL;
+    disp->driver.wake_cb    = NULL;
+    if (!same("pacing")) return false;
+
+    printf("%-12s idle second: %u handler calls; change after idling woke %u of 20 times, drawn after "
+           "%u ticks at worst; period %u ms while frames overrun, %u ms after\n", "pacing", (unsigned)idle,
+           (unsigned)woken, (unsigned)worst, slow, fast);
+    return idle <= 2 && woken == 20 && worst == 0 && slow > LV_REFR_MIN_PERIOD && fast == LV_REFR_MIN_PERIOD;
+}
+#endif
+
+#if LV_USE_PROF
+static int lines;
+
+static void printLine(const char * /*line*/)
+{
+    lines++;
+}
+
+static bool prof(void)
+{
+    lv_obj_t *scr = screen();
+    lv_obj_t *btn = lv_btn_create(scr, NULL);
+    lv_obj_set_pos(btn, 10, 10);
+    lv_label_set_text(lv_label_create(btn, NULL), "OK");
+    lv_obj_t *sl = lv_slider_create(scr, NULL);
+    lv_obj_set_pos(sl, 10, 120);
+    lv_obj_set_width(sl, 110);
+    frame();
+
+    lv_prof_clear();
+    frame();                        // nothing to draw: not kept
+    uint16_t idle = lv_prof_get_cnt();
+
+    bool counted = true, slider = false;
+    for (int i = 0; i < 12; i++) {
+        lv_slider_set_value(sl, (i + 1) * 8, LV_ANIM_OFF);
+        frame();
+        const lv_prof_frame_t *f = lv_prof_get_frame(0);
+        if (f == NULL) return false;
+        counted &= f->flushes == flushes && f->flush_bytes == flushed * sizeof(lv_color_t) && f->areas > 0;
+        for (int t = 0; t < f->design_cnt; t++) {
+            if (strcmp(f->design[t].type, "lv_slider") == 0 && f->design[t].calls > 0) slider = true;
+        }
+    }
+    uint16_t kept = lv_prof_get_cnt();
+    lines = 0;
+    lv_prof_dump(printLine);
+    lv_prof_clear();
+    if (!same("prof")) return false;
+
+    printf("%-12s %u kept of 12 frames, %u after an empty refresh, %d lines dumped\n", "prof", kept, idle, lines);
+    return idle == 0 && kept == LV_PROF_FRAMES && counted && slider && lines >= 2 * LV_PROF_FRAMES;
+}
+#endif
+
+static const struct {
+    const char *name;
+    bool (*run)(void);
+} cases[] = {
+    { "scroll", scroll },
+    { "join", join },
+    { "overflow", overflow },
+#if LV_USE_DRAW_LIST
+    { "drawlist", drawList },
+#endif
+#if LV_USE_OCCLUSION
+    { "occlusion", occlusion },
+#endif
+#if LV_USE_STRIP_HASH
+    { "hash", hash },
+#endif
+#if LV_USE_COL_DELTA
+    { "coldelta", colDelta },
+#endif
+#if LV_USE_REFR_PACING
+    { "pacing", pacing },
+#endif
+#if LV_USE_PROF
+    { "prof", prof },
+#endif
+};
+
+int main(int argc, char **argv)
+{
+    int failed = 0;
+
+    setup();
+
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        bool selected = argc < 2;
+        for (int a = 1; a < argc; a++) {
+            if (strcmp(argv[a], cases[c].name) == 0) selected = true;
+        }
+        if (!selected) continue;
+
+        srand(c + 1);
+        if (!cases[c].run()) {
+            printf("%-12s FAILED\n", cases[c].name);
+            failed++;
+        }
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,15 @@
+/*
+ * Storage for the host stand-ins declared in mbed.h. Link this into every
+ * host program that uses them.
+ */
+
+#include "mbed.h"
+
+host_bus_stats_t host_bus_stats;
+uint64_t host_now_ns;
+uint32_t host_ns_per_call = 2000;
+std::multimap<uint64_t, std::function<void()> > host_irqs;
+
+PinName host_dc_pin = NC;
+int     host_dc;
+void  (*host_spi_sink)(int dc, const uint8_t *data, int len);
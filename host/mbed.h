@@ -0,0 +1,216 @@
+/*
+ * Host stand-in for the parts of mbed-os used by the display stack, so the
+ * Adafruit_ST7735 driver can be built and measured on Linux.
+ *
+ * SPI and DigitalOut don't drive anything; they count what the driver asks
+ * of them in host_bus_stats so two versions of the driver can be compared
+ * byte for byte and call for call.
+ *
+ * Time is simulated. Event-driven SPI transfers complete on the simulated
+ * clock after the time the bytes would take on the wire. Blocking writes
+ * move the clock forward by their wire time plus host_ns_per_call,
+ * host_advance_ns() does the same for CPU work, and sleep() jumps to the
+ * next pending completion, running its callback as the interrupt would.
+ *
+ * A panel model can watch the bus by setting host_spi_sink: it gets every
+ * byte sent, blocking or not, together with the level of the DC pin named
+ * by host_dc_pin at the time.
+ */
+
+#ifndef HOST_MBED_H
+#define HOST_MBED_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <functional>
+#include <map>
+
+#define DEVICE_SPI_ASYNCH   1
+#define SPI_EVENT_COMPLETE  (1 << 3)
+
+typedef int PinName;
+
+#define NC ((PinName)-1)
+
+struct host_bus_stats_t {
+    uint32_t spi_calls;     // SPI::write() calls, single byte or buffered
+    uint32_t spi_bytes;     // bytes clocked out on MOSI
+    uint32_t gpio_writes;   // DigitalOut assignments (CS, DC, RST)
+    uint32_t frequency;     // last SPI clock requested by the driver
+    uint32_t wait_ms;       // milliseconds spent in wait_ms()
+    uint32_t async_calls;   // SPI::transfer() calls
+};
+
+extern host_bus_stats_t host_bus_stats;
+
+// Simulated time in nanoseconds, the interrupts due on it, and the fixed
+// cost of one blocking SPI::write() call
+extern uint64_t host_now_ns;
+extern uint32_t host_ns_per_call;
+extern std::multimap<uint64_t, std::function<void()> > host_irqs;
+
+// Bus observer, see above
+extern PinName host_dc_pin;
+extern int     host_dc;
+extern void  (*host_spi_sink)(int dc, const uint8_t *data, int len);
+
+inline void host_spi_out(const void *data, int len)
+{
+    if (host_spi_sink) host_spi_sink(host_dc, (const uint8_t *)data, len);
+}
+
+inline void host_fire_until(uint64_t t)
+{
+    while (!host_irqs.empty() && host_irqs.begin()->first <= t) {
+        std::multimap<uint64_t, std::function<void()> >::iterator it = host_irqs.begin();
+        std::function<void()> irq = it->second;
+        if (it->first > host_now_ns) host_now_ns = it->first;
+        host_irqs.erase(it);
+        irq();
+    }
+    if (t > host_now_ns) host_now_ns = t;
+}
+
+inline void host_advance_ns(uint64_t ns)
+{
+    host_fire_until(host_now_ns + ns);
+}
+
+inline uint64_t host_wire_ns(uint32_t bytes)
+{
+    return (uint64_t)bytes * 8 * 1000000000ULL / host_bus_stats.frequency;
+}
+
+// Wait for the next interrupt
+inline void sleep(void)
+{
+    if (!host_irqs.empty()) host_fire_until(host_irqs.begin()->first);
+}
+
+template <typename F>
+class Callback;
+
+template <typename R, typename... Args>
+class Callback<R(Args...)>
+{
+public:
+    Callback() { }
+    Callback(R (*func)(Args...)) : _f(func) { }
+    template <typename T, typename U>
+    Callback(U *obj, R (T::*method)(Args...))
+        : _f([obj, method](Args... args) { return (obj->*method)(args...); }) { }
+
+    R call(Args... args) const { return _f(args...); }
+    R operator()(Args... args) const { return _f(args...); }
+    operator bool() const { return (bool)_f; }
+
+private:
+    std::function<R(Args...)> _f;
+};
+
+template <typename T, typename U, typename R, typename... Args>
+Callback<R(Args...)> callback(U *obj, R (T::*method)(Args...))
+{
+    return Callback<R(Args...)>(obj, method);
+}
+
+template <typename R, typename... Args>
+Callback<R(Args...)> callback(R (*func)(Args...))
+{
+    return Callback<R(Args...)>(func);
+}
+
+typedef Callback<void(int)> event_callback_t;
+
+inline void host_bus_reset(void)
+{
+    uint32_t f = host_bus_stats.frequency;
+    memset(&host_bus_stats, 0, sizeof(host_bus_stats));
+    host_bus_stats.frequency = f;
+}
+
+class DigitalOut
+{
+public:
+    DigitalOut(PinName pin, int value = 0) : _pin(pin), _value(value)
+    {
+        if (_pin == host_dc_pin) host_dc = value;
+    }
+
+    void write(int value)
+    {
+        _value = value;
+        host_bus_stats.gpio_writes++;
+        if (_pin == host_dc_pin) host_dc = value;
+    }
+    int read(void) { return _value; }
+
+    DigitalOut &operator= (int value)
+    {
+        write(value);
+        return *this;
+    }
+    operator int() { return _value; }
+
+private:
+    PinName _pin;
+    int     _value;
+};
+
+class SPI
+{
+public:
+    SPI(PinName /*mosi*/, PinName /*miso*/, PinName /*sclk*/) { }
+
+    void format(int /*bits*/, int /*mode*/ = 0) { }
+    void frequency(int hz = 1000000) { host_bus_stats.frequency = hz; }
+
+    int write(int value)
+    {
+        uint8_t byte = value;
+
+        host_bus_stats.spi_calls++;
+        host_bus_stats.spi_bytes++;
+        host_spi_out(&byte, 1);
+        host_advance_ns(host_wire_ns(1) + host_ns_per_call);
+        return 0xFF;
+    }
+
+    int write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length)
+    {
+        int bytes = tx_length > rx_length ? tx_length : rx_length;
+
+        host_bus_stats.spi_calls++;
+        host_bus_stats.spi_bytes += bytes;
+        host_spi_out(tx_buffer, tx_length);
+        if (rx_buffer) memset(rx_buffer, 0xFF, rx_length);
+        host_advance_ns(host_wire_ns(bytes) + host_ns_per_call);
+        return bytes;
+    }
+
+    template <typename Type>
+    int transfer(const Type *tx_buffer, int tx_length, Type *rx_buffer, int rx_length,
+                 const event_callback_t &cb, int event = SPI_EVENT_COMPLETE)
+    {
+        int bytes = (tx_length > rx_length ? tx_length : rx_length) * sizeof(Type);
+
+        host_bus_stats.async_calls++;
+        host_bus_stats.spi_bytes += bytes;
+        host_spi_out(tx_buffer, tx_length * sizeof(Type));
+        if (rx_buffer) memset(rx_buffer, 0xFF, rx_length * sizeof(Type));
+        host_advance_ns(host_ns_per_call);
+        host_irqs.insert(std::make_pair(host_now_ns + host_wire_ns(bytes),
+                                        [cb, event]() { cb.call(event); }));
+        return 0;
+    }
+};
+
+inline void wait_ms(int ms)
+{
+    host_bus_stats.wait_ms += ms;
+}
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * Host benchmark for Adafruit_ST7735: runs the driver against the counting
+ * stand-ins in host/mbed.h and the panel model in host/host_panel.h and
+ * reports what each operation costs on the bus.
+ *
+ * Build and run from the repository root:
+ *
+ *   g++ -O2 -DARDUINO=100 -Ihost -Ilib/Adafruit_ST7735_ID2150 \
+ *       "-Ilib/Adafruit GFX Library_ID13" host/st7735_bench.cpp \
+ *       host/mbed.cpp lib/Adafruit_ST7735_ID2150/Adafruit_ST7735.cpp \
+ *       "lib/Adafruit GFX Library_ID13/Adafruit_GFX.cpp" -o st7735_bench
+ *   ./st7735_bench [spi_hz] [ns_per_call] [render_us] [out.ppm]
+ *
+ * ns_per_call models the fixed cost of one SPI call on the target (driver
+ * entry, peripheral setup, busy-wait); it defaults to 2us, roughly what
+ * mbed's nRF52 SPI takes for a single byte. render_us is the CPU time LVGL
+ * is assumed to spend rendering one 10-row strip in the flush pipeline
+ * comparison. If out.ppm is given, the screen as drawn by the primitives
+ * is written there.
+ *
+ * Each line gives the SPI calls, command and data bytes as decoded by the
+ * panel, GPIO writes, simulated time and the part of it the bytes alone
+ * take on the wire, then the driver's window cache counters.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "mbed.h"
+#include "host_panel.h"
+#include "Adafruit_ST7735.h"
+
+static HostPanel panel;
+static uint64_t  t0;
+
+static void report(Adafruit_ST7735 &tft, const char *name)
+{
+    const ST7735WindowStats &win = tft.windowStats();
+    const HostPanelStats    &bus = panel.stats();
+
+    printf("%-26s %7u calls %7u async %5u cmd %8u data %6u gpio  %9.1f us (wire %9.1f)"
+           "  win %u/%u reused, -%u CASET -%u RASET\n", name,
+           (unsigned)host_bus_stats.spi_calls, (unsigned)host_bus_stats.async_calls,
+           (unsigned)bus.commands, (unsigned)bus.dataBytes,
+           (unsigned)host_bus_stats.gpio_writes, (host_now_ns - t0) / 1000.0,
+           panel.busNs(host_bus_stats.frequency) / 1000.0, (unsigned)win.reused,
+           (unsigned)win.windows, (unsigned)win.casetSkipped, (unsigned)win.rasetSkipped);
+    host_bus_reset();
+    panel.resetStats();
+    tft.resetWindowStats();
+    t0 = host_now_ns;
+}
+
+// Stand-in for the LVGL side of src/main.cpp: two 10-row buffers, a strip
+// may only be rendered into a buffer whose previous flush has completed.
+static volatile bool flushing[2];
+static int           flush_buf;
+static uint32_t      overlapped;
+
+static void flush_ready(void)
+{
+    flushing[flush_buf] = false;
+}
+
+static void pipeline(Adafruit_ST7735 &tft, uint16_t *bufs[2], uint32_t render_ns, bool async,
+                     bool bits12 = false)
+{
+    int b = 0;
+
+    for (int y = 0; y < tft.height(); y += 10) {
+        while (flushing[b]) sleep();        // lv_refr_vdb_flush() spin
+        if (tft.busy()) overlapped++;
+        host_advance_ns(render_ns);         // render strip into bufs[b]
+
+        tft.setAddrWindow(0, y, tft.width() - 1, y + 9);
+        if (async) {
+            flushing[b] = true;
+            flush_buf = b;
+            if (bits12) {
+                tft.pushBytes444Async((uint8_t *)bufs[b], tft.width() * 10, true,
+                                      callback(flush_ready));
+            } else {
+                tft.pushColorsAsync(bufs[b], tft.width() * 10, callback(flush_ready));
+            }
+        } else {
+            tft.pushColors(bufs[b], tft.width() * 10);
+        }
+        b ^= 1;
+    }
+    while (tft.busy()) sleep();
+}
+
+int main(int argc, char **argv)
+{
+    static uint16_t frame[ST7735_TFTWIDTH * ST7735_TFTHEIGHT];
+    uint16_t *bufs[2] = { frame, frame + ST7735_TFTWIDTH * 10 };
+    uint32_t render_ns = 3000 * 1000;
+    int      ox, oy;
+
+    Adafruit_ST7735 tft(0, 1, 2, 3, 4, 5);
+
+    panel.attach(4);
+
+    if (argc > 2) host_ns_per_call = strtoul(argv[2], NULL, 0);
+    if (argc > 3) render_ns = strtoul(argv[3], NULL, 0) * 1000;
+
+    uint32_t blocked, gaps = 0, ms;
+
+    tft.initST7789();
+    blocked = host_bus_stats.wait_ms;
+    report(tft, "initST7789");
+
+    // Same again stepped, the waits left to the caller
+    tft.beginST7789();
+    while ((ms = tft.initStep()) != 0) {
+        gaps += ms;
+        host_advance_ns(ms * 1000000ULL);
+    }
+    printf("panel start-up: initST7789() waits %u ms, initStep() gaps %u ms\n",
+           (unsigned)blocked, (unsigned)gaps);
+    if (argc > 1) tft.setFrequency(strtoul(argv[1], NULL, 0));
+    report(tft, "beginST7789/initStep");
+
+    for (uint32_t i = 0; i < sizeof(frame) / sizeof(frame[0]); i++) frame[i] = i;
+
+    tft.setAddrWindow(0, 0, tft.width() - 1, tft.height() - 1);
+    tft.pushColors(frame, tft.width() * tft.height());
+    report(tft, "pushColors full frame");
+
+    tft.setAddrWindow(0, 0, tft.width() - 1, tft.height() - 1);
+    tft.pushBytes((const uint8_t *)frame, sizeof(frame));
+    report(tft, "pushBytes full frame");
+
+    for (int y = 0; y < tft.height(); y += 10) {
+        tft.setAddrWindow(0, y, tft.width() - 1, y + 9);
+        tft.pushColors(frame, tft.width() * 10);
+    }
+    report(tft, "pushColors 10-row strips");
+
+    tft.fillScreen(ST7735_RED);
+    ox = panel.originX();
+    oy = panel.originY();
+    report(tft, "fillScreen");
+
+    tft.fillRect(10, 10, 20, 20, ST7735_BLUE);
+    report(tft, "fillRect 20x20");
+
+    for (int i = 0; i < 100; i++) tft.drawPixel(i, i, ST7735_WHITE);
+    report(tft, "drawPixel x100");
+
+    tft.drawCircle(60, 60, 40, ST7735_GREEN);
+    report(tft, "drawCircle r=40");
+
+    tft.fillRoundRect(10, 100, 100, 60, 12, ST7735_CYAN);
+    report(tft, "fillRoundRect 100x60");
+
+    tft.drawLine(0, 0, tft.width() - 1, 100, ST7735_YELLOW);
+    report(tft, "drawLine shallow");
+
+    tft.drawTriangle(10, 10, 120, 40, 40, 200, ST7735_MAGENTA);
+    report(tft, "drawTriangle");
+
+    static uint8_t icon[64 * 64 / 8];
+    for (uint32_t i = 0; i < sizeof(icon); i++) icon[i] = i * 37;
+    tft.drawBitmap(20, 20, icon, 64, 64, ST7735_WHITE, ST7735_BLACK);
+    report(tft, "drawBitmap 64x64 bg");
+
+    tft.drawRGBBitmap(20, 20, frame, 64, 64);
+    report(tft, "drawRGBBitmap 64x64");
+
+    // A status line as print() draws it, once through the generic
+    // Adafruit_GFX glyph code and once through the driver's
+    tft.setCursor(0, 200);
+    tft.setTextColor(ST7735_WHITE, ST7735_BLACK);
+    tft.setTextSize(2);
+    for (const char *p = "12:34 87%"; *p; p++) {
+        tft.Adafruit_GFX::drawChar(tft.getCursorX(), tft.getCursorY(), *p,
+                                   ST7735_WHITE, ST7735_BLACK, 2, 2);
+        tft.setCursor(tft.getCursorX() + 12, tft.getCursorY());
+    }
+    report(tft, "text x2 bg, GFX drawChar");
+    tft.setCursor(0, 200);
+    tft.print("12:34 87%");
+    report(tft, "text x2 bg, glyph blit");
+    tft.setCursor(0, 220);
+    tft.setTextColor(ST7735_YELLOW);
+    tft.print("12:34 87%");
+    report(tft, "text x2 transparent");
+
+    if (argc > 4 && !panel.writePPM(argv[4], ox, oy, tft.width(), tft.height())) {
+        perror(argv[4]);
+        return 1;
+    }
+
+    {
+        GFXcanvas8 can(tft.width(), tft.height());
+        for (int i = 0; i < tft.width() * tft.height(); i++) can.getBuffer()[i] = i;
+        tft.drawCanvas(0, 0, can);
+        while (tft.busy()) sleep();
+        printf("canvas RAM: GFXcanvas8 %d bytes, GFXcanvas16 %d\n",
+               tft.width() * tft.height(), tft.width() * tft.height() * 2);
+        report(tft, "drawCanvas 8-bit full");
+
+        can.fillScreen(0x22);
+        tft.flushCanvas(can);
+        while (tft.busy()) sleep();
+        report(tft, "flushCanvas after fill");
+        can.setCursor(10, 100);
+        can.setTextColor(0xFF);
+        can.print("12:34");
+        can.drawFastHLine(0, 120, 135, 0xE0);
+        tft.flushCanvas(can);
+        while (tft.busy()) sleep();
+        report(tft, "flushCanvas text + line");
+    }
+
+    for (int x = 0; x < tft.width(); x++) tft.drawFastVLine(x, 0, tft.height(), ST7735_BLACK);
+    report(tft, "drawFastVLine full width");
+
+    static uint8_t fillbuf[1024];
+    tft.setFillBuffer(fillbuf, sizeof(fillbuf));
+    tft.fillScreen(ST7735_RED);
+    report(tft, "fillScreen, 1K fill buffer");
+    tft.setFillBuffer(NULL, 0);
+
+    pipeline(tft, bufs, render_ns, false);
+    report(tft, "flush pipeline, blocking");
+
+    overlapped = 0;
+    pipeline(tft, bufs, render_ns, true);
+    printf("%u of %d strips rendered while the previous one was on the bus\n",
+           (unsigned)overlapped, tft.height() / 10);
+    report(tft, "flush pipeline, async");
+
+    pipeline(tft, bufs, render_ns, true, true);
+    report(tft, "flush pipeline, 12-bit");
+
+    tft.setLowFrameRate(8);
+    tft.setPartialArea(0, tft.height());
+    printf("low power: panel refreshes at %d Hz\n", panel.frameRateHz());
+    report(tft, "enter low power");
+
+    tft.setPartialArea(0, 0);
+    printf("normal: panel refreshes at %d Hz\n", panel.frameRateHz());
+    report(tft, "leave low power");
+
+    return 0;
+}
@@ -0,0 +1,362 @@
+/*
+ * Pixel-exact check of Adafruit_ST7735's own drawing primitives against the
+ * generic Adafruit_GFX versions. Every case is drawn on the driver, decoded
+ * back into GRAM by host/host_panel.h, and drawn on a GFXcanvas16 of the
+ * same size, which uses Adafruit_GFX's pixel-by-pixel code; the two images
+ * must be identical. Shapes are random and often hang off the screen edges.
+ * The scroll case scrolls part of the screen in hardware between two drawing
+ * passes, checking the driver's row remapping against the same rows
+ * rotated in the reference. The 12-bit case pushes strips through
+ * pushBytes444(), the reference holding each pixel as the panel widens the
+ * expected RGB444 value back, then draws at 16 bits again. The indexed case
+ * blits a GFXcanvas8, larger than one bounce buffer and often larger than
+ * the screen, through a random palette or as RGB332. The dirty case draws
+ * on a 1, 8 or 16-bit canvas in rounds, sending each with flushCanvas().
+ * The text case prints in the classic font and two GFXfonts at random
+ * sizes, with and without a background.
+ *
+ * Build and run from the repository root:
+ *
+ *   g++ -O2 -DARDUINO=100 -Ihost -Ilib/Adafruit_ST7735_ID2150 \
+ *       "-Ilib/Adafruit GFX Library_ID13" host/st7735_check.cpp \
+ *       host/mbed.cpp lib/Adafruit_ST7735_ID2150/Adafruit_ST7735.cpp \
+ *       "lib/Adafruit GFX Library_ID13/Adafruit_GFX.cpp" -o st7735_check
+ *   ./st7735_check [cases]
+ *
+ * Exits non-zero and names the first differing pixel on a mismatch.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "mbed.h"
+#include "host_panel.h"
+#include "Adafruit_ST7735.h"
+#include "Fonts/FreeSans9pt7b.h"
+#include "Fonts/FreeMonoBold12pt7b.h"
+
+static HostPanel panel;
+static int       ox, oy;            // controller position of pixel (0,0)
+
+static int rnd(int lo, int hi)
+{
+    return lo + rand() % (hi - lo + 1);
+}
+
+static bool same(Adafruit_ST7735 &tft, GFXcanvas16 &ref, const char *name, int n)
+{
+    const uint16_t *buf = ref.getBuffer();
+
+    for (int y = 0; y < tft.height(); y++) {
+        for (int x = 0; x < tft.width(); x++) {
+            uint16_t got  = panel.shown(x + ox, y + oy);
+            uint16_t want = buf[y * tft.width() + x];
+            if (got != want) {
+                printf("%s #%d: pixel (%d,%d) is %04x, expected %04x\n",
+                       name, n, x, y, got, want);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Draw, scroll a random band of rows by a random amount, draw again. The
+// hardware wraps the band around, so the reference rotates its rows.
+static bool scrolled(Adafruit_ST7735 &tft, GFXcanvas16 &ref, int x0, int y0,
+                     int w, int h, uint16_t c)
+{
+    static uint16_t rows[ST7735_TFTWIDTH * ST7735_TFTHEIGHT];
+    static uint16_t strip[ST7735_TFTWIDTH * 40];
+    int W = tft.width(), H = tft.height();
+    int top = rnd(0, H / 2), n = rnd(2, H - top), dy = rnd(-n + 1, n - 1);
+    uint16_t *buf = ref.getBuffer();
+
+    if (!tft.setScrollArea(top, n)) return false;
+
+    tft.fillCircle(x0, y0, h, c);
+    ref.fillCircle(x0, y0, h, c);
+    tft.drawLine(0, top, W - 1, top + n - 1, ~c);
+    ref.drawLine(0, top, W - 1, top + n - 1, ~c);
+
+    tft.scroll(dy);
+    memcpy(rows, buf + top * W, n * W * 2);
+    for (int i = 0; i < n; i++) {
+        int to = ((i + dy) % n + n) % n;
+        memcpy(buf + (top + to) * W, rows + i * W, W * 2);
+    }
+
+    tft.fillRect(x0 - w, y0 - h, w, 2 * h, c ^ 0x5555);
+    ref.fillRect(x0 - w, y0 - h, w, 2 * h, c ^ 0x5555);
+
+    // A strip in memory order, pushed the way src/main.cpp flushes LVGL
+    int sy = rnd(0, H - 40), sh = rnd(1, 40);
+    for (int i = 0; i < W * sh; i++) {
+        strip[i] = rand();
+        buf[sy * W + i] = (strip[i] << 8) | (strip[i] >> 8);
+    }
+    tft.setAddrWindow(0, sy, W - 1, sy + sh - 1);
+    tft.pushColorsAsync(strip, W * sh, Callback<void()>());
+    while (tft.busy()) sleep();
+    return true;
+}
+
+// Expected RGB444 value of a pixel, as the panel shows it in RGB565
+static uint16_t as444(uint16_t c, int x, int y, bool dither)
+{
+    static const uint8_t bayer[4][4] = {
+        { 0, 8, 2, 10 }, { 12, 4, 14, 6 }, { 3, 11, 1, 9 }, { 15, 7, 13, 5 }
+    };
+    int t = dither ? bayer[y & 3][x & 3] : 8;
+    int r = ((c >> 11) + t / 8) / 2, g = ((c >> 5 & 0x3F) + t / 4) / 4, b = ((c & 0x1F) + t / 8) / 2;
+
+    if (r > 15) r = 15;
+    if (g > 15) g = 15;
+    if (b > 15) b = 15;
+    return (r << 1 | r >> 3) << 11 | (g << 2 | g >> 2) << 5 | (b << 1 | b >> 3);
+}
+
+// Two strips one under the other at 12 bits, the second continuing the
+// first one's RAMWR, then a 16-bit rectangle across them
+static void packed12(Adafruit_ST7735 &tft, GFXcanvas16 &ref, int x0, int y0, uint16_t c)
+{
+    static uint8_t strips[2][ST7735_TFTWIDTH * 40 * 2];
+    int W = tft.width(), H = tft.height();
+    int x = rnd(0, W - 1), w = rnd(1, W - x), y = rnd(0, H - 1);
+    bool dither = rand() & 1;
+    uint16_t *buf = ref.getBuffer();
+
+    tft.setScrollArea(0, 0);    // dithering follows memory rows
+    for (int k = 0; k < 2 && y < H; k++) {
+        int h = rnd(1, H - y < 40 ? H - y : 40);
+        uint8_t *strip = strips[k];     // the first is still on the bus
+
+        for (int i = 0; i < w * h; i++) {
+            uint16_t v = rand();
+            int px = x + i % w, py = y + i / w;
+
+            strip[2 * i]     = v >> 8;
+            strip[2 * i + 1] = v;
+            buf[py * W + px] = as444(v, px + ox, py + oy, dither);
+        }
+        tft.setAddrWindow(x, y, x + w - 1, y + h - 1);
+        if (k) tft.pushBytes444(strip, w * h, dither);
+        else tft.pushBytes444Async(strip, w * h, dither, Callback<void()>());
+        y += h;
+    }
+    tft.fillRect(x0 - 20, y0 - 20, 40, 40, c);
+    ref.fillRect(x0 - 20, y0 - 20, 40, 40, c);
+}
+
+// RGB565 colour of a GFXcanvas8 pixel value, as drawCanvas() expands it
+static uint16_t color8(const GFXcanvas8 &can, uint8_t v)
+{
+    const uint16_t *pal = can.getPalette();
+    return pal ? pal[v] : GFXcanvas8::color332(v);
+}
+
+// A random GFXcanvas8 with a shape on it, blitted with drawCanvas()
+static void indexed(Adafruit_ST7735 &tft, GFXcanvas16 &ref, int x0, int y0, uint16_t c)
+{
+    static uint16_t palette[256];
+    int w = rnd(1, tft.width() + 60), h = rnd(1, tft.height() + 60);
+    GFXcanvas8 can(w, h);
+    uint8_t *pix = can.getBuffer();
+
+    for (int i = 0; i < 256; i++) palette[i] = rand();
+    can.setPalette(rand() & 1 ? palette : NULL);
+    for (int i = 0; i < w * h; i++) pix[i] = rand();
+    can.fillCircle(w / 2, h / 2, w / 3, c);
+
+    tft.drawCanvas(x0 - w / 2, y0 - h / 2, can);
+    while (tft.busy()) sleep();
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) ref.drawPixel(x0 - w / 2 + i, y0 - h / 2 + j, color8(can, pix[j * w + i]));
+    }
+}
+
+// Colour the canvas buffers hold at (i, j), as stored
+static uint16_t stored(Adafruit_GFX &can, int depth, int i, int j, int w)
+{
+    switch (depth) {
+    case 1:
+        return ((GFXcanvas1 &)can).getBuffer()[j * ((w + 7) / 8) + i / 8] & (0x80 >> (i & 7)) ? 0xFFFF : 0x1234;
+    case 8:
+        return color8((GFXcanvas8 &)can, ((GFXcanvas8 &)can).getBuffer()[j * w + i]);
+    }
+    return ((GFXcanvas16 &)can).getBuffer()[j * w + i];
+}
+
+// Rounds of shapes on a canvas, each sent with flushCanvas(); the screen
+// must end up showing the whole canvas
+static void dirty(Adafruit_ST7735 &tft, GFXcanvas16 &ref, int x0, int y0)
+{
+    int depth = rnd(0, 2) == 0 ? 1 : rand() & 1 ? 8 : 16;
+    int w = rnd(1, tft.width() + 40), h = rnd(1, tft.height() + 40);
+    int cx = x0 - w / 2, cy = y0 - h / 2;
+    Adafruit_GFX *can = depth == 1 ? (Adafruit_GFX *)new GFXcanvas1(w, h) :
+                        depth == 8 ? (Adafruit_GFX *)new GFXcanvas8(w, h) :
+                                     (Adafruit_GFX *)new GFXcanvas16(w, h);
+
+    for (int round = 0; round < 4; round++) {
+        int cw = can->width(), ch = can->height(), k = rnd(1, 6);
+
+        if (round == 0) can->fillScreen(rand());
+        while (k--) {
+            int px = rnd(-10, cw + 10), py = rnd(-10, ch + 10);
+            uint16_t c = rand();
+
+            switch (rnd(0, 4)) {
+            case 0: can->drawPixel(px, py, c); break;
+            case 1: can->drawLine(px, py, rnd(-10, cw + 10), rnd(-10, ch + 10), c); break;
+            case 2: can->fillCircle(px, py, rnd(0, 20), c); break;
+            case 3: can->fillRect(px, py, rnd(1, 30), rnd(1, 30), c); break;
+            case 4: can->drawChar(px, py, 'A' + rnd(0, 25), c, c, 1); break;
+            }
+        }
+        if (depth == 1) tft.flushCanvas(*(GFXcanvas1 *)can, 0xFFFF, 0x1234, cx, cy);
+        else if (depth == 8) tft.flushCanvas(*(GFXcanvas8 *)can, cx, cy);
+        else tft.flushCanvas(*(GFXcanvas16 *)can, cx, cy);
+        can->setRotation(rnd(0, 3) & (depth == 8 ? 0 : 3));
+    }
+    while (tft.busy()) sleep();
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) ref.drawPixel(cx + i, cy + j, stored(*can, depth, i, j, w));
+    }
+    delete can;
+}
+
+// A random string printed on both, wrapping at the screen edge
+static void text(Adafruit_ST7735 &tft, GFXcanvas16 &ref, int x0, int y0, uint16_t c)
+{
+    static const GFXfont *fonts[] = { NULL, NULL, &FreeSans9pt7b, &FreeMonoBold12pt7b };
+    const GFXfont *font = fonts[rnd(0, 3)];
+    uint8_t sx = rnd(1, 4), sy = rnd(1, 4);
+    uint16_t bg = rand() & 1 ? c : ~c;
+    bool cp437 = rand() & 1;
+    char str[24];
+    int n = rnd(1, sizeof(str) - 1);
+
+    for (int i = 0; i < n; i++) str[i] = font ? rnd(' ', '~') : rnd(1, 255);
+    str[n] = 0;
+
+    Adafruit_GFX *gfx[2] = { &tft, &ref };
+    for (int k = 0; k < 2; k++) {
+        gfx[k]->setFont(font);
+        gfx[k]->setTextSize(sx, sy);
+        gfx[k]->setTextColor(c, bg);
+        gfx[k]->cp437(cp437);
+        gfx[k]->setCursor(x0 - 60, y0);
+        gfx[k]->print(str);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int cases = argc > 1 ? atoi(argv[1]) : 200;
+    int failed = 0;
+
+    Adafruit_ST7735 tft(0, 1, 2, 3, 4, 5);
+
+    panel.attach(4);
+    tft.initST7789();
+
+    tft.fillScreen(0);
+    ox = panel.originX();
+    oy = panel.originY();
+
+    int W = tft.width(), H = tft.height();
+    GFXcanvas16 ref(W, H);
+
+    static uint8_t  bits[64 * 8], mask[64 * 8];
+    static uint16_t rgb[64 * 64];
+
+    for (int kind = 0; kind < 14; kind++) {
+        static const char *names[] = {
+            "drawLine", "drawCircle", "drawTriangle", "fillTriangle",
+            "drawBitmap", "drawBitmap bg", "drawRGBBitmap",
+            "drawRGBBitmap mask", "drawRoundRect", "scroll area", "12-bit push",
+            "indexed canvas", "flushCanvas dirty", "text"
+        };
+        int ok = 0;
+
+        srand(kind + 1);
+        for (int n = 0; n < cases; n++) {
+            uint16_t c = rand();
+            int x0 = rnd(-30, W + 30), y0 = rnd(-30, H + 30);
+            int x1 = rnd(-30, W + 30), y1 = rnd(-30, H + 30);
+            int x2 = rnd(-30, W + 30), y2 = rnd(-30, H + 30);
+            int w = rnd(1, 64), h = rnd(1, 64), r = rnd(0, 80);
+
+            for (unsigned i = 0; i < sizeof(bits); i++) {
+                bits[i] = rand();
+                mask[i] = rand();
+            }
+            for (unsigned i = 0; i < sizeof(rgb) / 2; i++) rgb[i] = rand();
+
+            tft.fillScreen(0);
+            ref.fillScreen(0);
+            switch (kind) {
+            case 0:
+                tft.drawLine(x0, y0, x1, y1, c);
+                ref.drawLine(x0, y0, x1, y1, c);
+                break;
+            case 1:
+                tft.drawCircle(x0, y0, r, c);
+                ref.drawCircle(x0, y0, r, c);
+                break;
+            case 2:
+                tft.drawTriangle(x0, y0, x1, y1, x2, y2, c);
+                ref.drawTriangle(x0, y0, x1, y1, x2, y2, c);
+                break;
+            case 3:
+                tft.fillTriangle(x0, y0, x1, y1, x2, y2, c);
+                ref.fillTriangle(x0, y0, x1, y1, x2, y2, c);
+                break;
+            case 4:
+                tft.drawBitmap(x0 - w / 2, y0 - h / 2, bits, w, h, c);
+                ref.drawBitmap(x0 - w / 2, y0 - h / 2, bits, w, h, c);
+                break;
+            case 5:
+                tft.drawBitmap(x0 - w / 2, y0 - h / 2, bits, w, h, c, ~c);
+                ref.drawBitmap(x0 - w / 2, y0 - h / 2, bits, w, h, c, ~c);
+                break;
+            case 6:
+                tft.drawRGBBitmap(x0 - w / 2, y0 - h / 2, rgb, w, h);
+                ref.drawRGBBitmap(x0 - w / 2, y0 - h / 2, rgb, w, h);
+                break;
+            case 7:
+                tft.drawRGBBitmap(x0 - w / 2, y0 - h / 2, rgb, mask, w, h);
+                ref.drawRGBBitmap(x0 - w / 2, y0 - h / 2, rgb, mask, w, h);
+                break;
+            case 8:
+                tft.drawRoundRect(x0 - w, y0 - h, 2 * w, 2 * h, r / 4, c);
+                ref.drawRoundRect(x0 - w, y0 - h, 2 * w, 2 * h, r / 4, c);
+                break;
+            case 9:
+                if (!scrolled(tft, ref, x0, y0, w, h, c)) {
+                    printf("scroll area: not supported\n");
+                    return 1;
+                }
+                break;
+            case 10:
+                packed12(tft, ref, x0, y0, c);
+                break;
+            case 11:
+                indexed(tft, ref, x0, y0, c);
+                break;
+            case 12:
+                dirty(tft, ref, x0, y0);
+                break;
+            case 13:
+                text(tft, ref, x0, y0, c);
+                break;
+            }
+            if (same(tft, ref, names[kind], n)) ok++;
+            else break;
+        }
+        printf("%-20s %4d/%d identical\n", names[kind], ok, cases);
+        if (ok != cases) failed++;
+    }
+
+    return failed ? 1 : 0;
+}
@@ -1170,6 +1170,18 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 
     } // End classic vs custom font
 }
+/**************************************************************************/
+/*!
+    @brief  The 'classic' built-in font, for subclasses with their own
+            drawChar(): 5 bytes per character, one per column, bit 0 the
+            top row
+    @returns  Pointer to the font data (PROGMEM on AVR)
+*/
+/**************************************************************************/
+const uint8_t *Adafruit_GFX::classicFont(void) {
+    return font;
+}
+
 /**************************************************************************/
 /*!
     @brief  Print one byte/character of data, used to support print()
@@ -1656,6 +1668,59 @@ boolean Adafruit_GFX_Button::justReleased() { return (!currstate && laststate);
 // scanline pad).
 // NOT EXTENSIVELY TESTED YET.  MAY CONTAIN WORST BUGS KNOWN TO HUMANKIND.
 
+/**************************************************************************/
+/*!
+   @brief    Add a changed rectangle, merging it into one already tracked
+             if that costs little or there is no room left
+   @param    x0  Left column
+   @param    y0  Top row
+   @param    x1  Right column, inclusive
+   @param    y1  Bottom row, inclusive
+*/
+/**************************************************************************/
+void GFXdirty::add(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    int32_t area = (int32_t)(x1 - x0 + 1) * (y1 - y0 + 1);
+    int32_t bestCost = 0x7FFFFFFF;
+    uint8_t i, best = 0;
+
+    for(i=0; i<count; i++) {
+        Rect &r = rect[i];
+        if(x0 >= r.x0 && x1 <= r.x1 && y0 >= r.y0 && y1 <= r.y1) return;
+
+        // Pixels the merged rectangle would send that neither one holds
+        int32_t cost = (int32_t)((x1 > r.x1 ? x1 : r.x1) - (x0 < r.x0 ? x0 : r.x0) + 1) *
+                       ((y1 > r.y1 ? y1 : r.y1) - (y0 < r.y0 ? y0 : r.y0) + 1) -
+                       (int32_t)(r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1) - area;
+        if(cost < bestCost) {
+            bestCost = cost;
+            best     = i;
+        }
+    }
+    if(bestCost > GFX_DIRTY_SLACK && count < GFX_DIRTY_RECTS) {
+        Rect &r = rect[count++];
+        r.x0 = x0; r.y0 = y0; r.x1 = x1; r.y1 = y1;
+        return;
+    }
+
+    Rect m = rect[best];
+    if(x0 < m.x0) m.x0 = x0;
+    if(y0 < m.y0) m.y0 = y0;
+    if(x1 > m.x1) m.x1 = x1;
+    if(y1 > m.y1) m.y1 = y1;
+    rect[best] = m;
+
+    // The grown rectangle may now cover others
+    for(i=0; i<count; ) {
+        Rect &r = rect[i];
+        if(i != best && r.x0 >= m.x0 && r.x1 <= m.x1 && r.y0 >= m.y0 && r.y1 <= m.y1) {
+            rect[i] = rect[--count];
+            if(best == count) best = i;
+        } else {
+            i++;
+        }
+    }
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 1-bit canvas context for graphics
@@ -1724,6 +1789,7 @@ void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
         if(color) *ptr |=   0x80 >> (x & 7);
         else      *ptr &= ~(0x80 >> (x & 7));
 #endif
+        dirty.add(x, y, x, y);
     }
 }
 
@@ -1737,6 +1803,8 @@ void GFXcanvas1::fillScreen(uint16_t color) {
     if(buffer) {
         uint16_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
         memset(buffer, color ? 0xFF : 0x00, bytes);
+        dirty.clear();
+        dirty.add(0, 0, WIDTH - 1, HEIGHT - 1);
     }
 }
 
@@ -1747,7 +1815,8 @@ void GFXcanvas1::fillScreen(uint16_t color) {
    @param    h   Display height, in pixels
 */
 /**************************************************************************/
-GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h) : Adafruit_GFX(w, h),
+  palette(NULL) {
     uint32_t bytes = w * h;
     if((buffer = (uint8_t *)malloc(bytes))) {
         memset(buffer, 0, bytes);
@@ -1794,9 +1863,25 @@ void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
         }
 
         buffer[x + y * WIDTH] = color;
+        dirty.add(x, y, x, y);
     }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Widen an RGB332 value to RGB565, repeating the top bits
+    @param  index  RRRGGGBB
+    @returns  16-bit 5-6-5 Color
+*/
+/**************************************************************************/
+uint16_t GFXcanvas8::color332(uint8_t index) {
+    uint16_t r = index >> 5, g = index >> 2 & 0x07, b = index & 0x03;
+
+    return (r << 13 | (r >> 1) << 11) |
+           (g << 8 | g << 5) |
+           (b << 3 | b << 1 | b >> 1);
+}
+
 /**************************************************************************/
 /*!
     @brief  Fill the framebuffer completely with one color
@@ -1806,6 +1891,8 @@ void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
 void GFXcanvas8::fillScreen(uint16_t color) {
     if(buffer) {
         memset(buffer, color, WIDTH * HEIGHT);
+        dirty.clear();
+        dirty.add(0, 0, WIDTH - 1, HEIGHT - 1);
     }
 }
 
@@ -1842,6 +1929,7 @@ void GFXcanvas8::writeFastHLine(int16_t x, int16_t y,
     }
 
     memset(buffer + y * WIDTH + x, color, w);
+    dirty.add(x, y, x + w - 1, y);
 }
 
 /**************************************************************************/
@@ -1898,6 +1986,7 @@ void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
         }
 
         buffer[x + y * WIDTH] = color;
+        dirty.add(x, y, x, y);
     }
 }
 
@@ -1916,6 +2005,8 @@ void GFXcanvas16::fillScreen(uint16_t color) {
             uint32_t i, pixels = WIDTH * HEIGHT;
             for(i=0; i<pixels; i++) buffer[i] = color;
         }
+        dirty.clear();
+        dirty.add(0, 0, WIDTH - 1, HEIGHT - 1);
     }
 }
 
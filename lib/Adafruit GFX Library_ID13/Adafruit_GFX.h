@@ -47,11 +47,33 @@ class Adafruit_GFX : public Print {
     fillScreen(uint16_t color),
     // Optional and probably not necessary to change
     drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color),
-    drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
+    // Drawn pixel by pixel here; displays with an address window can
+    // batch them into spans or a single transfer
+    drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
+    drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+      int16_t w, int16_t h, uint16_t color),
+    drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+      int16_t w, int16_t h, uint16_t color, uint16_t bg),
+    drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+      int16_t w, int16_t h, uint16_t color),
+    drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+      int16_t w, int16_t h, uint16_t color, uint16_t bg),
+    drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+      int16_t w, int16_t h),
+    drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+      int16_t w, int16_t h),
+    drawRGBBitmap(int16_t x, int16_t y,
+      const uint16_t bitmap[], const uint8_t mask[],
+      int16_t w, int16_t h),
+    drawRGBBitmap(int16_t x, int16_t y,
+      uint16_t *bitmap, uint8_t *mask, int16_t w, int16_t h),
+    // A glyph is a pixel or rectangle per font pixel here
+    drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+      uint16_t bg, uint8_t size_x, uint8_t size_y);
 
   // These exist only with Adafruit_GFX (no subclass overrides)
   void
-    drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
     drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername,
       uint16_t color),
     fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
@@ -65,14 +87,6 @@ class Adafruit_GFX : public Print {
       int16_t radius, uint16_t color),
     fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
       int16_t radius, uint16_t color),
-    drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
-      int16_t w, int16_t h, uint16_t color),
-    drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
-      int16_t w, int16_t h, uint16_t color, uint16_t bg),
-    drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
-      int16_t w, int16_t h, uint16_t color),
-    drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
-      int16_t w, int16_t h, uint16_t color, uint16_t bg),
     drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
       int16_t w, int16_t h, uint16_t color),
     drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
@@ -84,19 +98,8 @@ class Adafruit_GFX : public Print {
       int16_t w, int16_t h),
     drawGrayscaleBitmap(int16_t x, int16_t y,
       uint8_t *bitmap, uint8_t *mask, int16_t w, int16_t h),
-    drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
-      int16_t w, int16_t h),
-    drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
-      int16_t w, int16_t h),
-    drawRGBBitmap(int16_t x, int16_t y,
-      const uint16_t bitmap[], const uint8_t mask[],
-      int16_t w, int16_t h),
-    drawRGBBitmap(int16_t x, int16_t y,
-      uint16_t *bitmap, uint8_t *mask, int16_t w, int16_t h),
     drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
       uint16_t bg, uint8_t size),
-    drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
-	      uint16_t bg, uint8_t size_x, uint8_t size_y),
     getTextBounds(const char *string, int16_t x, int16_t y,
       int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h),
     getTextBounds(const __FlashStringHelper *s, int16_t x, int16_t y,
@@ -212,6 +215,7 @@ class Adafruit_GFX : public Print {
   int16_t getCursorY(void) const { return cursor_y; };
 
  protected:
+  static const uint8_t *classicFont(void);
   void
     charBounds(char c, int16_t *x, int16_t *y,
       int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy);
@@ -292,6 +296,34 @@ class Adafruit_GFX_Button {
 };
 
 
+#ifndef GFX_DIRTY_RECTS
+#define GFX_DIRTY_RECTS 8   ///< Dirty rectangles a canvas tracks at most
+#endif
+#ifndef GFX_DIRTY_SLACK
+#define GFX_DIRTY_SLACK 32  ///< Unchanged pixels a merge may add, ~ a window
+#endif
+
+/// Rectangles of a canvas buffer changed since the last clear(), in buffer
+/// (rotation 0) coordinates. Rectangles are merged while that adds at most
+/// GFX_DIRTY_SLACK unchanged pixels, and whichever merge adds fewest once
+/// all GFX_DIRTY_RECTS are in use.
+class GFXdirty {
+ public:
+  GFXdirty(void) : count(0) {}
+  void     add(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  /**********************************************************************/
+  /*!
+   @brief    Forget all rectangles, e.g. once they have been sent
+  */
+  /**********************************************************************/
+  void     clear(void) { count = 0; }
+
+  /// A changed rectangle, corners inclusive
+  struct Rect { int16_t x0, y0, x1, y1; };
+  Rect     rect[GFX_DIRTY_RECTS]; ///< The rectangles, [0, count) in use
+  uint8_t  count;                 ///< Number of rectangles in use
+};
+
 /// A GFX 1-bit canvas context for graphics
 class GFXcanvas1 : public Adafruit_GFX {
  public:
@@ -306,12 +338,21 @@ class GFXcanvas1 : public Adafruit_GFX {
   */
   /**********************************************************************/
   uint8_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+   @brief    Get the regions changed since the dirty state was cleared
+   @returns  The canvas' dirty rectangles
+  */
+  /**********************************************************************/
+  GFXdirty &getDirty(void) { return dirty; }
  private:
   uint8_t *buffer;
+  GFXdirty dirty;
 };
 
 
-/// A GFX 8-bit canvas context for graphics
+/// A GFX 8-bit canvas context for graphics. Pixels are palette indices;
+/// without a palette they are read as RGB332.
 class GFXcanvas8 : public Adafruit_GFX {
  public:
   GFXcanvas8(uint16_t w, uint16_t h);
@@ -326,8 +367,32 @@ class GFXcanvas8 : public Adafruit_GFX {
   */
   /**********************************************************************/
   uint8_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+   @brief    Set the RGB565 colors the pixel values index
+   @param    pal  256 colors, not copied, or NULL for RGB332
+  */
+  /**********************************************************************/
+  void     setPalette(const uint16_t *pal) { palette = pal; }
+  /**********************************************************************/
+  /*!
+   @brief    Get the palette set with setPalette()
+   @returns  The palette, or NULL if pixels are RGB332
+  */
+  /**********************************************************************/
+  const uint16_t *getPalette(void) const { return palette; }
+  static uint16_t color332(uint8_t index);
+  /**********************************************************************/
+  /*!
+   @brief    Get the regions changed since the dirty state was cleared
+   @returns  The canvas' dirty rectangles
+  */
+  /**********************************************************************/
+  GFXdirty &getDirty(void) { return dirty; }
  private:
   uint8_t *buffer;
+  const uint16_t *palette;
+  GFXdirty dirty;
 };
 
 
@@ -346,8 +411,16 @@ class GFXcanvas16 : public Adafruit_GFX {
   */
   /**********************************************************************/
   uint16_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+   @brief    Get the regions changed since the dirty state was cleared
+   @returns  The canvas' dirty rectangles
+  */
+  /**********************************************************************/
+  GFXdirty &getDirty(void) { return dirty; }
  private:
   uint16_t *buffer;
+  GFXdirty dirty;
 };
 
 #endif // _ADAFRUIT_GFX_H
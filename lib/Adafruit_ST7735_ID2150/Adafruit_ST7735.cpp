@@ -27,26 +27,92 @@ inline uint16_t swapcolor(uint16_t x)
 
 // Constructor
 Adafruit_ST7735::Adafruit_ST7735(PinName mosi, PinName miso, PinName sck, PinName cs, PinName rs, PinName rst)
-    : lcdPort(mosi, miso, sck), _cs(cs), _rs(rs), _rst(rst), Adafruit_GFX(ST7735_TFTWIDTH, ST7735_TFTHEIGHT)
-{ }
+    : lcdPort(mosi, miso, sck), _cs(cs), _rs(rs), _rst(rst), Adafruit_GFX(ST7735_TFTWIDTH, ST7735_TFTHEIGHT),
+      _freq(ST7735_SPI_FREQUENCY), _bounce(NULL), _asyncLeft(0), _asyncBusy(false), _txn(0), _dc(true),
+      _winValid(false), _ramwr(false), _ramPixels(0), _bits12(false), _gramRows(0), _scrollH(0),
+      _segCount(0), _segNext(0), _segLeft(0xFFFFFFFF), _initPhase(INIT_RESET)
+{
+    resetWindowStats();
+    setFillBuffer(NULL, 0);
+}
 
 
-void Adafruit_ST7735::writecommand(uint8_t c)
+// Begin an SPI transaction: CS is asserted and stays asserted until the
+// matching endWrite(). Transactions nest, so the public drawing calls can be
+// used both on their own and between an outer startWrite()/endWrite().
+void Adafruit_ST7735::startWrite(void)
 {
-    _rs = 0;
-    _cs = 0;
-    lcdPort.write( c );
-    _cs = 1;
+    if (_txn++ == 0) {
+        waitIdle();
+        _cs = 0;
+    }
 }
 
 
-void Adafruit_ST7735::writedata(uint8_t c)
+void Adafruit_ST7735::endWrite(void)
 {
-    _rs = 1;
-    _cs = 0;
+    if (--_txn == 0 && !_asyncBusy) {
+        _cs = 1;
+    }
+}
+
+
+// Send a command byte. Must be called inside startWrite()/endWrite(); DC
+// is only driven when it actually changes.
+void Adafruit_ST7735::writeCommand(uint8_t c)
+{
+    waitIdle();
+    _ramwr = false;             // any command ends the running RAMWR
+    if (_dc) {
+        _rs = 0;
+        _dc = false;
+    }
     lcdPort.write( c );
+}
 
-    _cs = 1;
+
+// Send one data byte inside a transaction
+void Adafruit_ST7735::spiWrite(uint8_t d)
+{
+    waitIdle();
+    dataMode();
+    lcdPort.write( d );
+}
+
+
+// Send a run of data bytes inside a transaction
+void Adafruit_ST7735::writeBytes(const uint8_t *data, uint32_t len)
+{
+    waitIdle();
+    dataMode();
+    lcdPort.write((const char *)data, len, NULL, 0);
+}
+
+
+void Adafruit_ST7735::dataMode(void)
+{
+    if (!_dc) {
+        _rs = 1;
+        _dc = true;
+    }
+}
+
+
+// Stand-alone single-byte command and data writes, each in its own
+// transaction. Kept for callers outside the driver.
+void Adafruit_ST7735::writecommand(uint8_t c)
+{
+    startWrite();
+    writeCommand(c);
+    endWrite();
+}
+
+
+void Adafruit_ST7735::writedata(uint8_t c)
+{
+    startWrite();
+    spiWrite(c);
+    endWrite();
 }
 
 
@@ -221,44 +287,71 @@ st7789[] = {
 void Adafruit_ST7735::commandList(uint8_t *addr)
 {
 
-    uint8_t  numCommands, numArgs;
+    uint8_t  numCommands;
     uint16_t ms;
 
+    startWrite();
     numCommands = *addr++;   // Number of commands to follow
     while (numCommands--) {                // For each command...
-        writecommand(*addr++); //   Read, issue command
-        numArgs  = *addr++;    //   Number of args to follow
-        ms       = numArgs & DELAY;          //   If hibit set, delay follows args
-        numArgs &= ~DELAY;                   //   Mask out delay bit
-        while (numArgs--) {                  //   For each argument...
-            writedata(*addr++);  //     Read, issue argument
-        }
+        ms = commandStep(addr);
+        if (ms) wait_ms(ms);
+    }
+    endWrite();
+}
 
-        if (ms) {
-            ms = *addr++; // Read post-command delay time (ms)
-            if (ms == 255) ms = 500;    // If 255, delay for 500 ms
-            wait_ms(ms);
-        }
+// Issue the table command at 'addr' with its arguments, move 'addr' past
+// it and return the delay in ms it asks for, inside a transaction
+uint16_t Adafruit_ST7735::commandStep(uint8_t *&addr)
+{
+    uint8_t  numArgs;
+    uint16_t ms;
+
+    writeCommand(*addr++); //   Read, issue command
+    numArgs  = *addr++;    //   Number of args to follow
+    ms       = numArgs & DELAY;          //   If hibit set, delay follows args
+    numArgs &= ~DELAY;                   //   Mask out delay bit
+    if (numArgs) {                       //   Issue all arguments at once
+        writeBytes(addr, numArgs);
+        addr += numArgs;
+    }
+
+    if (ms) {
+        ms = *addr++; // Read post-command delay time (ms)
+        if (ms == 255) ms = 500;    // If 255, delay for 500 ms
     }
+    return ms;
 }
 
-// Initialization code common to both 'B' and 'R' type displays
-void Adafruit_ST7735::commonInit(uint8_t *cmdList)
+// Driver state and SPI set-up for a freshly reset panel
+void Adafruit_ST7735::commonSetup(void)
 {
     _init_height = 240;
     _init_width = 135;
 
     colstart  = rowstart = 0; // May be overridden in init func
+    _winValid = false;        // SWRESET forgets the address window,
+    _bits12   = false;        // the pixel format
+    _gramRows = 0;            // and the scroll area
+    _scrollH  = 0;
+    _partial  = false;
+    _st7789   = false;
 
     _rs = 1;
+    _dc = true;
     _cs = 1;
+    _txn = 0;
 
     // use default SPI format
     lcdPort.format(8, 0);
-    lcdPort.frequency(4000000);     // Lets try 4MHz
+    lcdPort.frequency(_freq);
+}
 
-    // toggle RST low to reset; CS low so it'll listen to us
-    _cs = 0;
+// Initialization code common to both 'B' and 'R' type displays
+void Adafruit_ST7735::commonInit(uint8_t *cmdList)
+{
+    commonSetup();
+
+    // toggle RST low to reset
     _rst = 1;
     wait_ms(500);
     _rst = 0;
@@ -267,6 +360,7 @@ void Adafruit_ST7735::commonInit(uint8_t *cmdList)
     wait_ms(500);
 
     if (cmdList) commandList(cmdList);
+    _initPhase = INIT_DONE;     // the blocking init*() calls are done
 }
 
 
@@ -280,8 +374,59 @@ void Adafruit_ST7735::initB(void)
 void Adafruit_ST7735::initST7789()
 {
     commonInit(st7789);
+    _st7789   = true;
+    _gramRows = 320;
     setRotation(0);
 }
+
+
+// Non-blocking version of initST7789(). The hardware reset is timed as
+// the ST7789 datasheet allows (RST low 10ms, 120ms before the first
+// command) rather than the 1.5s of commonInit(); the command table keeps
+// its delays, except that nothing needs to wait after the last command.
+void Adafruit_ST7735::beginST7789(void)
+{
+    commonSetup();
+    _st7789    = true;
+    _initCmd   = st7789;
+    _initLeft  = *_initCmd++;
+    _initPhase = INIT_RESET;
+}
+
+
+uint32_t Adafruit_ST7735::initStep(void)
+{
+    uint16_t ms = 0;
+
+    switch (_initPhase) {
+    case INIT_RESET:
+        _rst = 0;
+        _initPhase = INIT_WAKE;
+        return 10;
+
+    case INIT_WAKE:
+        _rst = 1;
+        _initPhase = INIT_COMMANDS;
+        return 120;
+
+    case INIT_COMMANDS:
+        startWrite();
+        while (_initLeft && ms == 0) {
+            _initLeft--;
+            ms = commandStep(_initCmd);
+        }
+        endWrite();
+        if (_initLeft) return ms;
+
+        _gramRows  = 320;
+        setRotation(0);
+        _initPhase = INIT_DONE;
+        return 0;
+
+    default:
+        return 0;
+    }
+}
 // Initialization for ST7735R screens (green or red tabs)
 void Adafruit_ST7735::initR(uint8_t options)
 {
@@ -303,120 +448,602 @@ void Adafruit_ST7735::initR(uint8_t options)
 
     // if black, change MADCTL color filter
     if (options == INITR_BLACKTAB) {
-        writecommand(ST7735_MADCTL);
-        writedata(0xC0);
+        startWrite();
+        writeCommand(ST7735_MADCTL);
+        spiWrite(0xC0);
+        endWrite();
     }
 
     tabcolor = options;
 }
 
+// Set the window subsequent pixel data fills and issue RAMWR. Safe both
+// inside and outside a transaction.
+//
+// The window last sent to the controller is remembered. RASET is always
+// programmed down to the bottom of the panel, so when the caller moves on to
+// the rows directly below (as LVGL does with its strips) the controller's
+// address counter is already in the right place and nothing needs to be
+// sent at all. Otherwise CASET is skipped when the columns are unchanged
+// and RASET when the start row is. Both rely on the panel continuing a
+// RAMWR across CS cycles until it sees another command, which the ST7735
+// and ST7789 do.
+//
+// With a scroll area set, screen rows inside it live at shifted memory
+// rows. The window is then sent as up to four row segments, and writeRam()
+// opens each one when the pixel data reaches it.
 void Adafruit_ST7735::setAddrWindow(uint8_t x0, uint8_t y0, uint8_t x1,
                                     uint8_t y1)
 {
+    _winStats.windows++;
+    _segXs    = x0 + colstart;
+    _segXe    = x1 + colstart;
+    _segYe    = y1 + rowstart;
+    _segCount = 0;
+    _segNext  = 0;
+
+    if (_scrollH == 0) {
+        _segLeft = 0xFFFFFFFF;
+        openWindow(_segXs, _segXe, y0 + rowstart);
+        return;
+    }
 
-    uint16_t xs = x0 + colstart;
-    uint16_t ys = y0 + rowstart;
+    // Cut the rows where the mapping to memory jumps: at the edges of the
+    // scroll area and at the point where the shifted area wraps around
+    int16_t top  = _scrollTop;
+    int16_t end  = _scrollTop + _scrollH;   // first row below the area
+    int16_t wrap = end - _scrollOff;        // first row shown from the area's top
+    int16_t y    = y0;
+
+    while (y <= y1) {
+        int16_t last = y1;
+        int16_t mem  = y;
+
+        if (y < top) {
+            if (last >= top) last = top - 1;
+        } else if (y < end) {
+            if (y < wrap) {
+                mem = y + _scrollOff;
+                if (last >= wrap) last = wrap - 1;
+            } else {
+                mem = y - (_scrollH - _scrollOff);
+                if (last >= end) last = end - 1;
+            }
+        }
+        if (_segCount && _segStart[_segCount - 1] + _segRows[_segCount - 1] == mem + rowstart) {
+            _segRows[_segCount - 1] += last - y + 1;
+        } else {
+            _segStart[_segCount] = mem + rowstart;
+            _segRows[_segCount]  = last - y + 1;
+            _segCount++;
+        }
+        y = last + 1;
+    }
+    nextSegment();
+}
 
-    uint16_t xe = x1 + colstart;
-    uint16_t ye = y1 + rowstart;
 
-    writecommand(ST7735_CASET); // Column addr set
-    writedata(xs >> 8);
-    writedata(xs & 0xFF);   // XSTART
-    writedata(xe >> 8);
-    writedata(xe & 0xFF);   // XEND
+// Open the next row segment of a split window and work out how much pixel
+// data fits in it before the one after it has to be opened
+void Adafruit_ST7735::nextSegment(void)
+{
+    uint8_t i = _segNext++;
 
-    writecommand(ST7735_RASET); // Row addr set
-    writedata(ys >> 8);
-    writedata(ys & 0xFF);   // YSTART
-    writedata(ye >> 8);
-    writedata(ye & 0xFF);   // YEND
+    if (_segNext < _segCount) {
+        _segLeft = (uint32_t)(_segXe - _segXs + 1) * _segRows[i] * 2;
+    } else {
+        _segLeft = 0xFFFFFFFF;
+    }
+    openWindow(_segXs, _segXe, _segStart[i]);
+}
 
-    writecommand(ST7735_RAMWR); // write to RAM
+
+// Send the window to the controller (coordinates include the panel
+// offsets), unless the running RAMWR already continues into it.
+void Adafruit_ST7735::openWindow(uint16_t xs, uint16_t xe, uint16_t ys)
+{
+    uint16_t bottom = _height - 1 + rowstart;
+    bool     sameCols;
+
+    _curYs = ys;
+
+#if ST7735_CACHE_WINDOW
+    sameCols = _winValid && xs == _winXs && xe == _winXe;
+    if (sameCols && _ramwr) {
+        uint16_t w   = xe - xs + 1;
+        uint32_t row = _winYs + _ramPixels / w;
+        if ((_ramPixels % w) == 0 && row == ys && ys <= bottom) {
+            _winStats.reused++;
+            return;
+        }
+    }
+#else
+    sameCols = false;
+#endif
+
+    startWrite();
+    if (sameCols) {
+        _winStats.casetSkipped++;
+    } else {
+        uint8_t col[4] = { (uint8_t)(xs >> 8), (uint8_t)xs, (uint8_t)(xe >> 8), (uint8_t)xe };
+        writeCommand(ST7735_CASET); // Column addr set
+        writeBytes(col, 4);         // XSTART, XEND
+    }
+    if (sameCols && ys == _winYs) {
+        _winStats.rasetSkipped++;
+    } else {
+        uint8_t row[4] = { (uint8_t)(ys >> 8), (uint8_t)ys, (uint8_t)(bottom >> 8), (uint8_t)bottom };
+        writeCommand(ST7735_RASET); // Row addr set
+        writeBytes(row, 4);         // YSTART, panel bottom
+    }
+    writeCommand(ST7735_RAMWR); // write to RAM
+    endWrite();
+
+    _winXs = xs;
+    _winXe = xe;
+    _winYs = ys;
+    _winValid  = true;
+    _ramwr     = true;
+    _ramPixels = 0;
 }
 
 
-void Adafruit_ST7735::pushColor(uint16_t color)
+// Send pixel data for the current window inside a transaction. When the
+// window was split by the scroll area the data is cut at the end of each
+// segment and the next one opened.
+void Adafruit_ST7735::writeRam(const uint8_t *data, uint32_t len)
 {
-    _rs = 1;
-    _cs = 0;
+    if (_bits12) colmod16();
+    while (len > _segLeft) {
+        uint32_t n = _segLeft;
+        if (n) {
+            writeBytes(data, n);
+            _ramPixels += n / 2;
+        }
+        data += n;
+        len  -= n;
+        nextSegment();
+    }
+    writeBytes(data, len);
+    _ramPixels += len / 2;
+    if (_segLeft != 0xFFFFFFFF) _segLeft -= len;
+}
 
-    lcdPort.write( color >> 8 );
-    lcdPort.write( color );
-    _cs = 1;
+
+void Adafruit_ST7735::pushColor(uint16_t color)
+{
+    startWrite();
+    writePixel(color);
+    endWrite();
 }
 
 
 void Adafruit_ST7735::pushColors(uint16_t *color, uint32_t len)
 {
-    _rs = 1;
-    _cs = 0;
-    while (len--) {
+    startWrite();
+    writePixels(color, len);
+    endWrite();
+}
+
+
+// Write one pixel at the current window position, inside a transaction
+void Adafruit_ST7735::writePixel(uint16_t color)
+{
+    uint8_t buf[2] = { (uint8_t)(color >> 8), (uint8_t)color };
+
+    writeRam(buf, 2);
+}
 
-        uint16_t c = *color;
-        color++;
-        lcdPort.write( c >> 8 );
-        lcdPort.write( c & 0xFF );
+
+// Stream a run of pixels inside a transaction. They are staged big-endian
+// in _burst and sent with the buffered SPI write, so the per-call overhead
+// is paid once per ST7735_BURST_BYTES rather than once per byte.
+void Adafruit_ST7735::writePixels(const uint16_t *color, uint32_t len)
+{
+    if (_fill == _burst) _fillValid = false;
+    while (len) {
+        uint32_t n = len < sizeof(_burst) / 2 ? len : sizeof(_burst) / 2;
+        for (uint32_t i = 0; i < n; i++) {
+            uint16_t c = *color++;
+            _burst[2 * i]     = c >> 8;
+            _burst[2 * i + 1] = c & 0xFF;
+        }
+        writeRam(_burst, n * 2);
+        len -= n;
     }
-    _cs = 1;
 }
 
 
+// Send pixel data that is already in panel byte order. No staging and no
+// per-pixel work: the caller's buffer goes straight to the SPI peripheral.
+void Adafruit_ST7735::pushBytes(const uint8_t *data, size_t len)
+{
+    startWrite();
+    writeRam(data, len);
+    endWrite();
+}
 
-void Adafruit_ST7735::drawPixel(int16_t x, int16_t y, uint16_t color)
+
+// 12-bit transfers. The packed stream is 3/4 of the RGB565 one; the
+// conversion runs in place, front to back, since every pixel pair's 3
+// output bytes end before the next pair's 4 input bytes start.
+void Adafruit_ST7735::pushBytes444(uint8_t *data, uint32_t pixels, bool dither)
 {
+    if (!open444(pixels)) {
+        widen444(data, pixels, dither);
+        pushBytes(data, pixels * 2);
+        return;
+    }
+    uint32_t len = pack444(data, pixels, dither);
 
-    if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
+    startWrite();
+    writeBytes(data, len);
+    _ramPixels += pixels;
+    endWrite();
+}
 
-    setAddrWindow(x, y, x + 1, y + 1);
 
-    _rs = 1;
-    _cs = 0;
+void Adafruit_ST7735::pushBytes444Async(uint8_t *data, uint32_t pixels, bool dither,
+                                        Callback<void()> done)
+{
+    if (!open444(pixels)) {
+        widen444(data, pixels, dither);
+        pushBytesAsync(data, pixels * 2, done);
+        return;
+    }
+    asyncStart(data, pack444(data, pixels, dither), pixels, done);
+}
 
-    lcdPort.write( color >> 8 );
-    lcdPort.write( color );
 
-    _cs = 1;
+// Switch the panel to 12 bits per pixel for the current window. COLMOD
+// ends the running RAMWR, so the window is sent again. An odd pixel count
+// is sent with a padding pixel: the window is then closed at its last row
+// so the padding wraps onto the first pixel, whose value it repeats.
+bool Adafruit_ST7735::open444(uint32_t pixels)
+{
+    if (pixels < 2 || _segCount > 1) return false;
+
+    startWrite();
+    if (!_bits12) {
+        writeCommand(ST7735_COLMOD);
+        spiWrite(ST7735_COLMOD_12BIT);
+        _bits12   = true;
+        _winValid = false;
+    }
+    if (pixels & 1) {
+        uint16_t ye = _segCount ? _segStart[0] + _segRows[0] - 1 : _segYe;
+        uint8_t  col[4] = { (uint8_t)(_segXs >> 8), (uint8_t)_segXs, (uint8_t)(_segXe >> 8), (uint8_t)_segXe };
+        uint8_t  row[4] = { (uint8_t)(_curYs >> 8), (uint8_t)_curYs, (uint8_t)(ye >> 8), (uint8_t)ye };
+
+        writeCommand(ST7735_CASET);
+        writeBytes(col, 4);
+        writeCommand(ST7735_RASET);
+        writeBytes(row, 4);
+        writeCommand(ST7735_RAMWR);
+        _winValid  = false;         // the cache assumes RASET to the bottom
+        _ramwr     = true;
+        _ramPixels = 0;
+    } else if (!_winValid) {
+        openWindow(_segXs, _segXe, _curYs);
+    }
+    endWrite();
+    return true;
 }
 
 
-void Adafruit_ST7735::drawFastVLine(int16_t x, int16_t y, int16_t h,
-                                    uint16_t color)
+// Back to 16 bits per pixel before a 16-bit write into the current window
+void Adafruit_ST7735::colmod16(void)
 {
+    startWrite();
+    writeCommand(ST7735_COLMOD);
+    spiWrite(ST7735_COLMOD_16BIT);
+    _bits12   = false;
+    _winValid = false;
+    openWindow(_segXs, _segXe, _curYs);
+    endWrite();
+}
 
-    // Rudimentary clipping
-    if ((x >= _width) || (y >= _height)) return;
-    if ((y + h - 1) >= _height) h = _height - y;
-    setAddrWindow(x, y, x, y + h - 1);
 
-    uint8_t hi = color >> 8, lo = color;
-    _rs = 1;
-    _cs = 0;
-    while (h--) {
-        lcdPort.write( hi );
-        lcdPort.write( lo );
+// 4x4 Bayer matrix, thresholds 0..15
+static const uint8_t bayer4[4][4] = {
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 },
+};
+
+// RGB565 to RGB444. Each component gets the threshold t (0..15), scaled
+// to the bits it loses, added before it is cut to 4 bits; without
+// dithering the threshold is the midpoint, which rounds.
+static inline uint16_t to444(uint16_t c, uint8_t t)
+{
+    uint16_t r = (c >> 11) + (t >> 3);
+    uint16_t g = ((c >> 5) & 0x3F) + (t >> 2);
+    uint16_t b = (c & 0x1F) + (t >> 3);
+
+    return (r > 31 ? 0xF00 : (r >> 1) << 8) |
+           (g > 63 ? 0x0F0 : (g >> 2) << 4) |
+           (b > 31 ? 0x00F : b >> 1);
+}
+
+// Pack big-endian RGB565 to RGB444 in place: R1G1 B1R2 G2B2 for every
+// pixel pair, dithered by memory position. Returns the packed length,
+// padded to whole pairs with the first pixel.
+uint32_t Adafruit_ST7735::pack444(uint8_t *data, uint32_t pixels, bool dither)
+{
+    uint16_t x = _segXs, y = _curYs, first = 0;
+    uint8_t *out = data;
+
+    for (uint32_t i = 0; i < pixels; i++) {
+        uint16_t c = (data[2 * i] << 8) | data[2 * i + 1];
+        uint16_t p = to444(c, dither ? bayer4[y & 3][x & 3] : 8);
+
+        if (i & 1) {
+            out[1] |= p >> 8;
+            out[2]  = p;
+            out += 3;
+        } else {
+            if (i == 0) first = p;
+            out[0] = p >> 4;
+            out[1] = p << 4;
+        }
+        if (++x > _segXe) {
+            x = _segXs;
+            y++;
+        }
     }
-    _cs = 1;
+    if (pixels & 1) {
+        out[1] |= first >> 8;
+        out[2]  = first;
+        out += 3;
+    }
+    return out - data;
 }
 
 
-void Adafruit_ST7735::drawFastHLine(int16_t x, int16_t y, int16_t w,
-                                    uint16_t color)
+// A 12-bit window that has to go out at 16 bits still gets 12-bit
+// colours, so it can't be told apart from its neighbours: every pixel is
+// replaced by the RGB565 value the panel widens its RGB444 value to. The
+// dither follows the memory rows of each segment, as pack444() does.
+void Adafruit_ST7735::widen444(uint8_t *data, uint32_t pixels, bool dither)
 {
+    uint8_t  seg  = 0;
+    uint16_t x    = _segXs;
+    uint16_t y    = _segCount ? _segStart[0] : _curYs;
+    uint16_t rows = _segCount ? _segRows[0] : 0;
+
+    for (uint32_t i = 0; i < pixels; i++) {
+        uint16_t c = (data[2 * i] << 8) | data[2 * i + 1];
+        uint16_t p = to444(c, dither ? bayer4[y & 3][x & 3] : 8);
+        uint16_t r = p >> 8, g = (p >> 4) & 0x0F, b = p & 0x0F;
+
+        c = (r << 12 | (r >> 3) << 11) | (g << 7 | (g >> 2) << 5) | (b << 1 | b >> 3);
+        data[2 * i]     = c >> 8;
+        data[2 * i + 1] = c;
+        if (++x > _segXe) {
+            x = _segXs;
+            y++;
+            if (rows && --rows == 0 && ++seg < _segCount) {
+                y    = _segStart[seg];
+                rows = _segRows[seg];
+            }
+        }
+    }
+}
 
-    // Rudimentary clipping
-    if ((x >= _width) || (y >= _height)) return;
-    if ((x + w - 1) >= _width)  w = _width - x;
-    setAddrWindow(x, y, x + w - 1, y);
 
-    uint8_t hi = color >> 8, lo = color;
-    _rs = 1;
+void Adafruit_ST7735::pushColorsAsync(const uint16_t *color, uint32_t len, Callback<void()> done)
+{
+    pushBytesAsync((const uint8_t *)color, len * 2, done);
+}
+
+
+// Start a non-blocking push. CS stays asserted until the last chunk
+// completes (or the enclosing transaction ends, whichever is later);
+// asyncEvent() chains the chunks from the SPI interrupt. Data that runs
+// across a scroll-area wrap needs a new window part way through, which
+// can't be sent from the interrupt, so that (rare) push is done blocking.
+void Adafruit_ST7735::pushBytesAsync(const uint8_t *data, size_t len, Callback<void()> done)
+{
+    if (len > _segLeft) {
+        pushBytes(data, len);
+        if (done) done();
+        return;
+    }
+    if (_bits12) colmod16();
+    asyncStart(data, len, len / 2, done);
+}
+
+
+void Adafruit_ST7735::asyncStart(const uint8_t *data, size_t len, uint32_t pixels,
+                                 Callback<void()> done)
+{
+    waitIdle();
+    dataMode();
+
+    _ramPixels += pixels;
+    if (_segLeft != 0xFFFFFFFF) _segLeft -= len;
+    _asyncBuf  = (const char *)data;
+    _asyncLeft = len;
+    _asyncDone = done;
+    _asyncBusy = true;
+
     _cs = 0;
-    while (w--) {
-        lcdPort.write( hi );
-        lcdPort.write( lo );
+    asyncNext();
+}
+
+
+void Adafruit_ST7735::asyncNext(void)
+{
+    if (_asyncLeft == 0) {
+        _asyncBusy = false;
+        if (_txn == 0) _cs = 1;
+        if (_asyncDone) _asyncDone();
+        return;
     }
-    _cs = 1;
+
+#if DEVICE_SPI_ASYNCH
+    uint32_t n = _asyncLeft < ST7735_ASYNC_CHUNK ? _asyncLeft : ST7735_ASYNC_CHUNK;
+    const char *buf = _asyncBuf;
+
+    _asyncBuf  += n;
+    _asyncLeft -= n;
+    lcdPort.transfer(buf, n, (char *)NULL, 0,
+                     callback(this, &Adafruit_ST7735::asyncEvent), SPI_EVENT_COMPLETE);
+#else
+    // No event-driven SPI on this target: fall back to a blocking write
+    // and report completion straight away.
+    lcdPort.write(_asyncBuf, _asyncLeft, NULL, 0);
+    _asyncLeft = 0;
+    asyncNext();
+#endif
+}
+
+
+void Adafruit_ST7735::asyncEvent(int event)
+{
+    (void)event;                    // only SPI_EVENT_COMPLETE is subscribed
+    asyncNext();
+}
+
+
+// Block until a pending pushColorsAsync() has released the bus.
+void Adafruit_ST7735::waitIdle(void)
+{
+    while (_asyncBusy) {
+        sleep();
+    }
+}
+
+
+// Solid-fill engine. Sends 'len' pixels of a single colour inside a
+// transaction by replaying a pattern buffer of repeated pixels, so a fill
+// costs one SPI call per buffer-full however large it is. The pattern is
+// kept between calls and only rebuilt (or grown) when the colour changes,
+// which makes runs of same-coloured lines and rectangles nearly free of CPU
+// work. The buffer is _burst unless setFillBuffer() supplied a bigger one.
+void Adafruit_ST7735::writeColor(uint16_t color, uint32_t len)
+{
+    uint32_t cap  = _fillLen / 2;
+    uint32_t want = len < cap ? len : cap;
+
+    if (!_fillValid || _fillColor != color) {
+        _fill[0]    = color >> 8;
+        _fill[1]    = color & 0xFF;
+        _fillColor  = color;
+        _fillPixels = 1;
+        _fillValid  = true;
+    }
+    // Grow the pattern by doubling what is already there
+    while (_fillPixels < want) {
+        uint32_t n = _fillPixels < want - _fillPixels ? _fillPixels : want - _fillPixels;
+        memcpy(_fill + _fillPixels * 2, _fill, n * 2);
+        _fillPixels += n;
+    }
+
+    while (len) {
+        uint32_t n = len < cap ? len : cap;
+        writeRam(_fill, n * 2);
+        len -= n;
+    }
+}
+
+
+// Use 'buf' (at least two bytes, ideally a few hundred) as the pattern
+// buffer for solid fills instead of the driver's small internal one, trading
+// RAM for fewer SPI calls per fill. Pass NULL to go back to the internal
+// buffer. The memory must stay valid while the driver uses it.
+void Adafruit_ST7735::setFillBuffer(uint8_t *buf, size_t len)
+{
+    if (buf == NULL || len < 2) {
+        buf = _burst;
+        len = sizeof(_burst);
+    }
+    _fill      = buf;
+    _fillLen   = len & ~1;
+    _fillValid = false;
+}
+
+
+// Transaction-level primitives. Adafruit_GFX brackets its compound shapes
+// with startWrite()/endWrite() and draws them through these, so a whole
+// circle or rounded rectangle is a single CS assertion.
+void Adafruit_ST7735::writePixel(int16_t x, int16_t y, uint16_t color)
+{
+    if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
+
+    setAddrWindow(x, y, x, y);
+    writePixel(color);
+}
+
+
+void Adafruit_ST7735::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                    uint16_t color)
+{
+    // Normalise negative sizes, then clip to the screen
+    if (w < 0) {
+        x += w + 1;
+        w = -w;
+    }
+    if (h < 0) {
+        y += h + 1;
+        h = -h;
+    }
+    if ((x >= _width) || (y >= _height) || (x + w <= 0) || (y + h <= 0)) return;
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        h += y;
+        y = 0;
+    }
+    if ((x + w - 1) >= _width)  w = _width  - x;
+    if ((y + h - 1) >= _height) h = _height - y;
+    if ((w == 0) || (h == 0)) return;
+
+    setAddrWindow(x, y, x + w - 1, y + h - 1);
+    writeColor(color, (uint32_t)w * h);
+}
+
+
+void Adafruit_ST7735::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                     uint16_t color)
+{
+    writeFillRect(x, y, 1, h, color);
+}
+
+
+void Adafruit_ST7735::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                     uint16_t color)
+{
+    writeFillRect(x, y, w, 1, color);
+}
+
+
+void Adafruit_ST7735::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    startWrite();
+    writePixel(x, y, color);
+    endWrite();
+}
+
+
+void Adafruit_ST7735::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                    uint16_t color)
+{
+    startWrite();
+    writeFastVLine(x, y, h, color);
+    endWrite();
+}
+
+
+void Adafruit_ST7735::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                    uint16_t color)
+{
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    endWrite();
 }
 
 
@@ -431,25 +1058,497 @@ void Adafruit_ST7735::fillScreen(uint16_t color)
 void Adafruit_ST7735::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                uint16_t color)
 {
+    startWrite();
+    writeFillRect(x, y, w, h, color);
+    endWrite();
+}
 
-    // rudimentary clipping (drawChar w/big text requires this)
-    if ((x >= _width) || (y >= _height)) return;
-    if ((x + w - 1) >= _width)  w = _width  - x;
-    if ((y + h - 1) >= _height) h = _height - y;
 
-    setAddrWindow(x, y, x + w - 1, y + h - 1);
+// Bresenham as in Adafruit_GFX, but each run of pixels along the major axis
+// is sent as one line rather than pixel by pixel. Shallow lines become
+// horizontal runs, steep ones vertical runs.
+void Adafruit_ST7735::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                uint16_t color)
+{
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    int16_t t;
 
-    uint8_t hi = color >> 8, lo = color;
-    _rs = 1;
-    _cs = 0;
-    for (y = h; y > 0; y--) {
-        for (x = w; x > 0; x--) {
-            lcdPort.write( hi );
-            lcdPort.write( lo );
+    if (steep) {
+        t = x0; x0 = y0; y0 = t;
+        t = x1; x1 = y1; y1 = t;
+    }
+    if (x0 > x1) {
+        t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+
+    int16_t dx    = x1 - x0;
+    int16_t dy    = abs(y1 - y0);
+    int16_t err   = dx / 2;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+    int16_t run   = x0;                 // first pixel of the current run
+
+    for (; x0 <= x1; x0++) {
+        err -= dy;
+        if (err < 0) {
+            if (steep) writeFastVLine(y0, run, x0 - run + 1, color);
+            else       writeFastHLine(run, y0, x0 - run + 1, color);
+            run  = x0 + 1;
+            y0  += ystep;
+            err += dx;
         }
     }
+    if (run <= x1) {
+        if (steep) writeFastVLine(y0, run, x1 - run + 1, color);
+        else       writeFastHLine(run, y0, x1 - run + 1, color);
+    }
+}
 
-    _cs = 1;
+
+// Midpoint circle producing the same pixels as Adafruit_GFX::drawCircle().
+// The points of one octant are grouped by row; each group [a, b] on row y is
+// a horizontal run in the four octants near the top and bottom and a
+// vertical run in the four near the sides.
+void Adafruit_ST7735::drawCircle(int16_t x0, int16_t y0, int16_t r,
+                                 uint16_t color)
+{
+    int16_t f     = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x     = 0;
+    int16_t y     = r;
+    int16_t xs    = 0;                  // first x of the group on row y
+
+    startWrite();
+    while (x < y) {
+        if (f >= 0) {
+            circleSpans(x0, y0, xs, x, y, color);
+            xs = x + 1;
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+    }
+    circleSpans(x0, y0, xs, x, y, color);
+    endWrite();
+}
+
+
+void Adafruit_ST7735::circleSpans(int16_t x0, int16_t y0, int16_t a, int16_t b,
+                                  int16_t y, uint16_t color)
+{
+    if (a == 0) {
+        // The group straddles an axis, so mirrored halves join up
+        writeFastHLine(x0 - b, y0 + y, 2 * b + 1, color);
+        writeFastHLine(x0 - b, y0 - y, 2 * b + 1, color);
+        writeFastVLine(x0 + y, y0 - b, 2 * b + 1, color);
+        writeFastVLine(x0 - y, y0 - b, 2 * b + 1, color);
+    } else {
+        int16_t n = b - a + 1;
+
+        writeFastHLine(x0 + a, y0 + y, n, color);
+        writeFastHLine(x0 - b, y0 + y, n, color);
+        writeFastHLine(x0 + a, y0 - y, n, color);
+        writeFastHLine(x0 - b, y0 - y, n, color);
+        writeFastVLine(x0 + y, y0 + a, n, color);
+        writeFastVLine(x0 + y, y0 - b, n, color);
+        writeFastVLine(x0 - y, y0 + a, n, color);
+        writeFastVLine(x0 - y, y0 - b, n, color);
+    }
+}
+
+
+// 1-bit bitmaps, same layout as Adafruit_GFX (rows padded to whole bytes,
+// MSB first). Program memory is ordinary memory here, so the const and RAM
+// variants share one implementation.
+void Adafruit_ST7735::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                 int16_t w, int16_t h, uint16_t color)
+{
+    writeBitmap(x, y, bitmap, w, h, color, 0, false);
+}
+
+
+void Adafruit_ST7735::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                 int16_t w, int16_t h, uint16_t color, uint16_t bg)
+{
+    writeBitmap(x, y, bitmap, w, h, color, bg, true);
+}
+
+
+void Adafruit_ST7735::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                 int16_t w, int16_t h, uint16_t color)
+{
+    writeBitmap(x, y, bitmap, w, h, color, 0, false);
+}
+
+
+void Adafruit_ST7735::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                 int16_t w, int16_t h, uint16_t color, uint16_t bg)
+{
+    writeBitmap(x, y, bitmap, w, h, color, bg, true);
+}
+
+
+// An opaque bitmap is one window over its visible part, expanded to
+// big-endian pixels on the stack and streamed in bursts. A transparent one
+// is drawn as the horizontal runs of set bits on each row.
+void Adafruit_ST7735::writeBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                                  int16_t w, int16_t h, uint16_t color, uint16_t bg,
+                                  bool opaque)
+{
+    int16_t byteWidth = (w + 7) / 8;
+    int16_t i0 = x < 0 ? -x : 0;
+    int16_t j0 = y < 0 ? -y : 0;
+    int16_t i1 = _width  - x < w ? _width  - x : w;
+    int16_t j1 = _height - y < h ? _height - y : h;
+
+    if (i0 >= i1 || j0 >= j1) return;
+
+    startWrite();
+    if (opaque) {
+        uint8_t  buf[ST7735_BURST_BYTES];
+        uint32_t n = 0;
+
+        setAddrWindow(x + i0, y + j0, x + i1 - 1, y + j1 - 1);
+        for (int16_t j = j0; j < j1; j++) {
+            const uint8_t *row = bitmap + j * byteWidth;
+            for (int16_t i = i0; i < i1; i++) {
+                uint16_t c = (row[i >> 3] & (0x80 >> (i & 7))) ? color : bg;
+                buf[n++] = c >> 8;
+                buf[n++] = c & 0xFF;
+                if (n == sizeof(buf)) {
+                    writeRam(buf, n);
+                    n = 0;
+                }
+            }
+        }
+        if (n) writeRam(buf, n);
+    } else {
+        for (int16_t j = j0; j < j1; j++) {
+            const uint8_t *row = bitmap + j * byteWidth;
+            int16_t i = i0;
+            while (i < i1) {
+                if (!(row[i >> 3] & (0x80 >> (i & 7)))) {
+                    i++;
+                    continue;
+                }
+                int16_t run = i;
+                while (i < i1 && (row[i >> 3] & (0x80 >> (i & 7)))) i++;
+                writeFastHLine(x + run, y + j, i - run, color);
+            }
+        }
+    }
+    endWrite();
+}
+
+
+// RGB565 bitmaps in native byte order, as Adafruit_GFX takes them
+void Adafruit_ST7735::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                                    int16_t w, int16_t h)
+{
+    writeRGBBitmap(x, y, bitmap, NULL, w, h);
+}
+
+
+void Adafruit_ST7735::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                                    int16_t w, int16_t h)
+{
+    writeRGBBitmap(x, y, bitmap, NULL, w, h);
+}
+
+
+void Adafruit_ST7735::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                                    const uint8_t mask[], int16_t w, int16_t h)
+{
+    writeRGBBitmap(x, y, bitmap, mask, w, h);
+}
+
+
+void Adafruit_ST7735::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                                    uint8_t *mask, int16_t w, int16_t h)
+{
+    writeRGBBitmap(x, y, bitmap, mask, w, h);
+}
+
+
+// Without a mask the visible part of the bitmap is a single window and one
+// pixel stream (one writePixels() call when it isn't clipped sideways).
+// With one, each horizontal run of opaque pixels gets its own window.
+void Adafruit_ST7735::writeRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap,
+                                     const uint8_t *mask, int16_t w, int16_t h)
+{
+    int16_t i0 = x < 0 ? -x : 0;
+    int16_t j0 = y < 0 ? -y : 0;
+    int16_t i1 = _width  - x < w ? _width  - x : w;
+    int16_t j1 = _height - y < h ? _height - y : h;
+
+    if (i0 >= i1 || j0 >= j1) return;
+
+    startWrite();
+    if (!mask) {
+        setAddrWindow(x + i0, y + j0, x + i1 - 1, y + j1 - 1);
+        if (i0 == 0 && i1 == w) {
+            writePixels(bitmap + j0 * w, (uint32_t)w * (j1 - j0));
+        } else {
+            for (int16_t j = j0; j < j1; j++) writePixels(bitmap + j * w + i0, i1 - i0);
+        }
+    } else {
+        int16_t bw = (w + 7) / 8;
+        for (int16_t j = j0; j < j1; j++) {
+            const uint8_t *row = mask + j * bw;
+            int16_t i = i0;
+            while (i < i1) {
+                if (!(row[i >> 3] & (0x80 >> (i & 7)))) {
+                    i++;
+                    continue;
+                }
+                int16_t run = i;
+                while (i < i1 && (row[i >> 3] & (0x80 >> (i & 7)))) i++;
+                setAddrWindow(x + run, y + j, x + i - 1, y + j);
+                writePixels(bitmap + j * w + run, i - run);
+            }
+        }
+    }
+    endWrite();
+}
+
+
+void Adafruit_ST7735::drawCanvas(int16_t x, int16_t y, const GFXcanvas8 &canvas)
+{
+    int16_t w = canvas.getRotation() & 1 ? canvas.height() : canvas.width();
+    int16_t h = canvas.getRotation() & 1 ? canvas.width() : canvas.height();
+
+    drawIndexedBitmap(x, y, canvas.getBuffer(), canvas.getPalette(), w, h);
+}
+
+
+void Adafruit_ST7735::drawIndexedBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                                        const uint16_t *palette, int16_t w, int16_t h)
+{
+    int16_t i0 = x < 0 ? -x : 0;
+    int16_t j0 = y < 0 ? -y : 0;
+    int16_t i1 = _width  - x < w ? _width  - x : w;
+    int16_t j1 = _height - y < h ? _height - y : h;
+
+    if (!bitmap || i0 >= i1 || j0 >= j1) return;
+
+    startWrite();
+    setAddrWindow(x + i0, y + j0, x + i1 - 1, y + j1 - 1);
+    writeIndexed(bitmap + j0 * w + i0, w, palette, i1 - i0, j1 - j0);
+    endWrite();
+}
+
+
+// Send w x h indexed pixels, rows 'stride' bytes apart, to the open window.
+// They are expanded into the bounce buffers in turn and each one pushed
+// asynchronously: pushBytesAsync() waits for the one before, so the buffer
+// being filled is never the one on the bus. Returns with the last buffer
+// still going out; the bitmap itself is not read from then on. The buffers
+// are allocated on the first call.
+void Adafruit_ST7735::writeIndexed(const uint8_t *bitmap, int16_t stride,
+                                   const uint16_t *palette, int16_t w, int16_t h)
+{
+    const uint32_t room = ST7735_BOUNCE_BYTES / 2;
+    const uint8_t *row = bitmap;
+    int16_t  left = w;              // pixels of the current row to go
+    uint32_t pixels = (uint32_t)w * h;
+    uint8_t  k = 0;
+
+    if (_bounce == NULL) _bounce = new uint8_t[2 * ST7735_BOUNCE_BYTES];
+    waitIdle();                     // an earlier call's last buffer
+    while (pixels) {
+        uint8_t *out = _bounce + k * ST7735_BOUNCE_BYTES;
+        uint32_t n = pixels < room ? pixels : room;
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint16_t c = palette ? palette[*row] : GFXcanvas8::color332(*row);
+            out[2 * i]     = c >> 8;
+            out[2 * i + 1] = c & 0xFF;
+            row++;
+            if (--left == 0) {
+                row += stride - w;
+                left = w;
+            }
+        }
+        pushBytesAsync(out, n * 2, Callback<void()>());
+        pixels -= n;
+        k ^= 1;
+    }
+}
+
+
+void Adafruit_ST7735::flushCanvas(GFXcanvas16 &canvas, int16_t x, int16_t y)
+{
+    int16_t w = canvas.getRotation() & 1 ? canvas.height() : canvas.width();
+
+    flushDirty(canvas.getDirty(), x, y, (const uint8_t *)canvas.getBuffer(), 16, w * 2, NULL);
+}
+
+
+void Adafruit_ST7735::flushCanvas(GFXcanvas8 &canvas, int16_t x, int16_t y)
+{
+    int16_t w = canvas.getRotation() & 1 ? canvas.height() : canvas.width();
+
+    flushDirty(canvas.getDirty(), x, y, canvas.getBuffer(), 8, w, canvas.getPalette());
+}
+
+
+void Adafruit_ST7735::flushCanvas(GFXcanvas1 &canvas, uint16_t color, uint16_t bg,
+                                  int16_t x, int16_t y)
+{
+    int16_t  w = canvas.getRotation() & 1 ? canvas.height() : canvas.width();
+    uint16_t colors[2] = { bg, color };
+
+    flushDirty(canvas.getDirty(), x, y, canvas.getBuffer(), 1, (w + 7) / 8, colors);
+}
+
+
+// Send each dirty rectangle of a canvas buffer with 'depth' bits per pixel
+// and rows 'stride' bytes apart, clipped to the screen, as one window.
+// 'colors' is the palette at 8 bits, background and foreground at 1.
+void Adafruit_ST7735::flushDirty(GFXdirty &dirty, int16_t x, int16_t y,
+                                 const uint8_t *buf, uint8_t depth, int16_t stride,
+                                 const uint16_t *colors)
+{
+    if (!buf) return;
+
+    startWrite();
+    for (uint8_t n = 0; n < dirty.count; n++) {
+        const GFXdirty::Rect &r = dirty.rect[n];
+        int16_t i0 = x + r.x0 < 0 ? -x : r.x0;
+        int16_t j0 = y + r.y0 < 0 ? -y : r.y0;
+        int16_t i1 = x + r.x1 >= _width  ? _width  - 1 - x : r.x1;
+        int16_t j1 = y + r.y1 >= _height ? _height - 1 - y : r.y1;
+
+        if (i0 > i1 || j0 > j1) continue;
+        setAddrWindow(x + i0, y + j0, x + i1, y + j1);
+        for (int16_t j = j0; j <= j1; j++) {
+            const uint8_t *row = buf + (int32_t)j * stride;
+            if (depth == 16) {
+                writePixels((const uint16_t *)row + i0, i1 - i0 + 1);
+            } else if (depth == 8) {
+                writeIndexed(row + i0, stride, colors, i1 - i0 + 1, j1 - j0 + 1);
+                break;
+            } else {
+                // Bits to pixels, staged in _burst like writePixels()
+                if (_fill == _burst) _fillValid = false;
+                for (int16_t i = i0; i <= i1; ) {
+                    uint32_t k = 0;
+                    for (; i <= i1 && k < sizeof(_burst); i++, k += 2) {
+                        uint16_t c = colors[row[i >> 3] >> (7 - (i & 7)) & 1];
+                        _burst[k]     = c >> 8;
+                        _burst[k + 1] = c & 0xFF;
+                    }
+                    writeRam(_burst, k);
+                }
+            }
+        }
+    }
+    dirty.clear();
+    endWrite();
+}
+
+
+void Adafruit_ST7735::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                               uint16_t bg, uint8_t size_x, uint8_t size_y)
+{
+    if (!size_x || !size_y) return;
+    if (!gfxFont) {
+        if ((x >= _width) || (y >= _height) ||
+            (x + 6 * size_x - 1 < 0) || (y + 8 * size_y - 1 < 0)) return;
+        if (!_cp437 && (c >= 176)) c++;
+
+        // The font is stored by columns; turn it into 6-pixel rows, the
+        // sixth column being the gap to the next character
+        const uint8_t *cols = classicFont() + c * 5;
+        uint8_t rows[8] = { 0 };
+        for (uint8_t i = 0; i < 5; i++) {
+            uint8_t line = cols[i];
+            for (uint8_t j = 0; j < 8; j++, line >>= 1) {
+                if (line & 1) rows[j] |= 0x80 >> i;
+            }
+        }
+        startWrite();
+        if (bg != color) glyphBlit(x, y, rows, 8, 6, 8, size_x, size_y, color, bg);
+        else glyphRuns(x, y, rows, 8, 6, 8, size_x, size_y, color);
+        endWrite();
+    } else {
+        const GFXglyph *glyph = gfxFont->glyph + (uint8_t)(c - gfxFont->first);
+
+        startWrite();
+        glyphRuns(x + glyph->xOffset * size_x, y + glyph->yOffset * size_y,
+                  gfxFont->bitmap + glyph->bitmapOffset, glyph->width,
+                  glyph->width, glyph->height, size_x, size_y, color);
+        endWrite();
+    }
+}
+
+
+// Glyph bitmaps: pixel (i, j) is bit j * stride + i, MSB first
+static inline bool glyphBit(const uint8_t *bits, uint16_t stride, uint8_t i, uint8_t j)
+{
+    uint16_t k = j * stride + i;
+
+    return bits[k >> 3] & (0x80 >> (k & 7));
+}
+
+
+// Each horizontal run of set pixels as a size_x-wide, size_y-high rectangle
+void Adafruit_ST7735::glyphRuns(int16_t x, int16_t y, const uint8_t *bits, uint16_t stride,
+                                uint8_t w, uint8_t h, uint8_t size_x, uint8_t size_y,
+                                uint16_t color)
+{
+    for (uint8_t j = 0; j < h; j++) {
+        uint8_t i = 0;
+        while (i < w) {
+            if (!glyphBit(bits, stride, i, j)) {
+                i++;
+                continue;
+            }
+            uint8_t run = i;
+            while (i < w && glyphBit(bits, stride, i, j)) i++;
+            writeFillRect(x + run * size_x, y + j * size_y, (i - run) * size_x, size_y, color);
+        }
+    }
+}
+
+
+// The whole glyph cell, clipped, as one window, staged in _burst across
+// row ends so each SPI write carries a full buffer
+void Adafruit_ST7735::glyphBlit(int16_t x, int16_t y, const uint8_t *bits, uint16_t stride,
+                                uint8_t w, uint8_t h, uint8_t size_x, uint8_t size_y,
+                                uint16_t color, uint16_t bg)
+{
+    int16_t x0 = x < 0 ? 0 : x;
+    int16_t y0 = y < 0 ? 0 : y;
+    int16_t x1 = x + w * size_x - 1 < _width  ? x + w * size_x - 1 : _width  - 1;
+    int16_t y1 = y + h * size_y - 1 < _height ? y + h * size_y - 1 : _height - 1;
+    uint32_t k = 0;
+
+    if (_fill == _burst) _fillValid = false;
+    setAddrWindow(x0, y0, x1, y1);
+    for (int16_t r = y0; r <= y1; r++) {
+        uint8_t j = (r - y) / size_y;
+        uint8_t i = (x0 - x) / size_x, rep = (x0 - x) % size_x;
+
+        for (int16_t col = x0; col <= x1; col++) {
+            uint16_t c = glyphBit(bits, stride, i, j) ? color : bg;
+            _burst[k]     = c >> 8;
+            _burst[k + 1] = c & 0xFF;
+            if ((k += 2) == sizeof(_burst)) {
+                writeRam(_burst, k);
+                k = 0;
+            }
+            if (++rep == size_x) {
+                rep = 0;
+                i++;
+            }
+        }
+    }
+    if (k) writeRam(_burst, k);
 }
 
 
@@ -531,8 +1630,11 @@ void Adafruit_ST7735::setRotation(uint8_t m)
     }
 #else
 
-    writecommand(TFT_MADCTL);
+    setScrollArea(0, 0);        // the area is only valid for rotation 0
+    startWrite();
+    writeCommand(TFT_MADCTL);
     rotation = m % 4;
+    _winValid = false;          // offsets and panel bottom change
     switch (rotation) {
     case 0: // Portrait
 #ifdef CGRAM_OFFSET
@@ -544,7 +1646,7 @@ void Adafruit_ST7735::setRotation(uint8_t m)
             rowstart = 0;
         }
 #endif
-        writedata(TFT_MAD_COLOR_ORDER);
+        spiWrite(TFT_MAD_COLOR_ORDER);
 
         _width  = _init_width;
         _height = _init_height;
@@ -560,7 +1662,7 @@ void Adafruit_ST7735::setRotation(uint8_t m)
             rowstart = 0;
         }
 #endif
-        writedata(TFT_MAD_MX | TFT_MAD_MV | TFT_MAD_COLOR_ORDER);
+        spiWrite(TFT_MAD_MX | TFT_MAD_MV | TFT_MAD_COLOR_ORDER);
 
         _width  = _init_height;
         _height = _init_width;
@@ -576,7 +1678,7 @@ void Adafruit_ST7735::setRotation(uint8_t m)
             rowstart = 80;
         }
 #endif
-        writedata(TFT_MAD_MX | TFT_MAD_MY | TFT_MAD_COLOR_ORDER);
+        spiWrite(TFT_MAD_MX | TFT_MAD_MY | TFT_MAD_COLOR_ORDER);
 
         _width  = _init_width;
         _height = _init_height;
@@ -591,11 +1693,12 @@ void Adafruit_ST7735::setRotation(uint8_t m)
             rowstart = 0;
         }
 #endif
-        writedata(TFT_MAD_MV | TFT_MAD_MY | TFT_MAD_COLOR_ORDER);
+        spiWrite(TFT_MAD_MV | TFT_MAD_MY | TFT_MAD_COLOR_ORDER);
         _width  = _init_height;
         _height = _init_width;
         break;
     }
+    endWrite();
 #endif
 }
 
@@ -606,3 +1709,151 @@ void Adafruit_ST7735::invertDisplay(boolean i)
 }
 
 
+// Window-setup counters since the last resetWindowStats()
+const ST7735WindowStats &Adafruit_ST7735::windowStats(void) const
+{
+    return _winStats;
+}
+
+
+void Adafruit_ST7735::resetWindowStats(void)
+{
+    memset(&_winStats, 0, sizeof(_winStats));
+}
+
+
+// Hardware vertical scrolling. The controller shows memory rows TFA..
+// TFA+VSA-1 starting from row VSP and wrapping, while the rows above and
+// below stay fixed. Only the ST7789 path sets _gramRows, and only rotation
+// 0 has memory rows running the same way as screen rows.
+bool Adafruit_ST7735::setScrollArea(int16_t top, int16_t height)
+{
+    if (height <= 0) {
+        if (_scrollH) scrollCommands(0, _gramRows, 0);
+        _scrollH = 0;
+        return true;
+    }
+    if (_gramRows == 0 || rotation != 0 || top < 0 || top + height > _height) return false;
+    if (top == _scrollTop && height == _scrollH) return true;
+
+    _scrollTop = top;
+    _scrollH   = height;
+    _scrollOff = 0;
+    scrollCommands(top + rowstart, height, top + rowstart);
+    return true;
+}
+
+
+// Partial mode. PTLAR counts the controller's rows, which screen rows
+// map onto directly in rotation 0 only; an area covering the screen is
+// sent as all of them, so it works in every rotation.
+bool Adafruit_ST7735::setPartialArea(int16_t top, int16_t height)
+{
+    uint16_t sr, er;
+
+    if (height <= 0) {
+        if (_partial) {
+            startWrite();
+            writeCommand(ST7735_NORON);
+            endWrite();
+            _partial = false;
+        }
+        return true;
+    }
+    if (top <= 0 && top + height >= _height) {
+        sr = 0;
+        er = (_gramRows ? _gramRows : 162) - 1;
+    } else if (rotation == 0 && top >= 0 && top + height <= _height) {
+        sr = top + rowstart;
+        er = top + height - 1 + rowstart;
+    } else {
+        return false;
+    }
+
+    uint8_t ptlar[4] = { (uint8_t)(sr >> 8), (uint8_t)sr, (uint8_t)(er >> 8), (uint8_t)er };
+
+    startWrite();
+    writeCommand(ST7735_PTLAR);
+    writeBytes(ptlar, 4);
+    if (!_partial) writeCommand(ST7735_PTLON);
+    endWrite();
+    _partial = true;
+    return true;
+}
+
+
+void Adafruit_ST7735::setIdleMode(bool idle)
+{
+    startWrite();
+    writeCommand(idle ? ST7735_IDMON : ST7735_IDMOFF);
+    endWrite();
+}
+
+
+void Adafruit_ST7735::setLowFrameRate(uint8_t div)
+{
+    uint8_t d = div >= 8 ? 3 : div >= 4 ? 2 : div >= 2 ? 1 : 0;
+
+    startWrite();
+    if (_st7789) {
+        // FRSEN gives partial and idle mode their own rate: the 60Hz line
+        // timing with the clock divided by 2^DIV
+        uint8_t frctrl1[3] = { (uint8_t)(0x10 | d), 0x0F, 0x0F };
+
+        writeCommand(ST7789_FRCTRL1);
+        writeBytes(frctrl1, 3);
+    } else {
+        // No divider: the longest line period and porches, or Rcmd1's rate.
+        // Built on the stack, as EasyDMA can't read flash
+        uint8_t rate[6] = { 0x01, 0x2C, 0x2D, 0x01, 0x2C, 0x2D };
+        if (d) {
+            rate[0] = rate[3] = 0x0F;
+            rate[1] = rate[2] = rate[4] = rate[5] = 0x3F;
+        }
+
+        writeCommand(ST7735_FRMCTR2);
+        writeBytes(rate, 3);
+        writeCommand(ST7735_FRMCTR3);
+        writeBytes(rate, 6);
+    }
+    endWrite();
+}
+
+
+void Adafruit_ST7735::scroll(int16_t dy)
+{
+    if (_scrollH == 0) return;
+
+    _scrollOff = ((_scrollOff - dy) % _scrollH + _scrollH) % _scrollH;
+    scrollCommands(0, 0, _scrollTop + rowstart + _scrollOff);
+}
+
+
+// VSCRDEF (skipped when vsa is 0) and VSCRSADD
+void Adafruit_ST7735::scrollCommands(uint16_t tfa, uint16_t vsa, uint16_t vsp)
+{
+    startWrite();
+    if (vsa) {
+        uint16_t bfa    = _gramRows - tfa - vsa;
+        uint8_t  def[6] = { (uint8_t)(tfa >> 8), (uint8_t)tfa, (uint8_t)(vsa >> 8),
+                            (uint8_t)vsa, (uint8_t)(bfa >> 8), (uint8_t)bfa };
+        writeCommand(ST7789_VSCRDEF);
+        writeBytes(def, 6);
+    }
+    uint8_t sa[2] = { (uint8_t)(vsp >> 8), (uint8_t)vsp };
+    writeCommand(ST7789_VSCRSADD);
+    writeBytes(sa, 2);
+    endWrite();
+}
+
+
+// Change the SPI clock. Takes effect once a pending pushColorsAsync() has
+// finished, and survives re-init.
+void Adafruit_ST7735::setFrequency(uint32_t hz)
+{
+    waitIdle();
+    _freq = hz;
+    lcdPort.frequency(_freq);
+}
+
+
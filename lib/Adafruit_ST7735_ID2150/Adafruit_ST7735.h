@@ -65,6 +65,38 @@
 #define ST7735_TFTHEIGHT_18  160
 #define ST7735_TFTHEIGHT  240
 
+// SPI clock used once the panel is initialised; the nRF52 SPI master tops
+// out at 8MHz. Override from build_flags or call setFrequency().
+#ifndef ST7735_SPI_FREQUENCY
+#define ST7735_SPI_FREQUENCY 8000000
+#endif
+
+// Bytes staged per buffered SPI write when streaming pixels
+#ifndef ST7735_BURST_BYTES
+#define ST7735_BURST_BYTES 128
+#endif
+
+// Largest single event-driven SPI transfer. The nRF52832 SPIM EasyDMA
+// length register is 8 bits wide, so longer runs are chained in chunks.
+#ifndef ST7735_ASYNC_CHUNK
+#define ST7735_ASYNC_CHUNK 254
+#endif
+
+// Size of each of the two buffers drawCanvas() expands pixels into, one
+// line of the longer screen side by default. Both are allocated from the
+// heap on the first indexed draw, 2 * ST7735_BOUNCE_BYTES (960) bytes, so
+// applications that never draw one don't pay for them
+#ifndef ST7735_BOUNCE_BYTES
+#define ST7735_BOUNCE_BYTES (2 * ST7735_TFTHEIGHT)
+#endif
+
+// Remember the controller's address window and skip CASET/RASET/RAMWR when
+// a new window can reuse it. Set to 0 for panels that drop out of RAMWR
+// when CS is released.
+#ifndef ST7735_CACHE_WINDOW
+#define ST7735_CACHE_WINDOW 1
+#endif
+
 #define ST7735_NOP     0x00
 #define ST7735_SWRESET 0x01
 #define ST7735_RDDID   0x04
@@ -85,9 +117,14 @@
 #define ST7735_RAMRD   0x2E
 
 #define ST7735_PTLAR   0x30
+#define ST7735_IDMOFF  0x38
+#define ST7735_IDMON   0x39
 #define ST7735_COLMOD  0x3A
 #define ST7735_MADCTL  0x36
 
+#define ST7735_COLMOD_12BIT 0x53    // COLMOD argument, 12/16 bits per pixel
+#define ST7735_COLMOD_16BIT 0x55
+
 #define ST7735_FRMCTR1 0xB1
 #define ST7735_FRMCTR2 0xB2
 #define ST7735_FRMCTR3 0xB3
@@ -122,6 +159,16 @@
 #define ST7735_WHITE   0xFFFF
 
 
+// setAddrWindow() bookkeeping, for measuring how much window setup the
+// address-window cache saves per frame
+struct ST7735WindowStats {
+    uint32_t windows;       // setAddrWindow() calls
+    uint32_t reused;        // continued the running RAMWR, nothing sent
+    uint32_t casetSkipped;  // columns unchanged, CASET not sent
+    uint32_t rasetSkipped;  // start row unchanged, RASET not sent
+};
+
+
 class Adafruit_ST7735 : public Adafruit_GFX
 {
 
@@ -129,29 +176,194 @@ public:
 
     Adafruit_ST7735(PinName mosi, PinName miso, PinName sck, PinName CS, PinName RS, PinName RST);
     void initST7789();
+
+    // Non-blocking initST7789(): beginST7789() returns straight away, then
+    // every initStep() sends what it can without waiting and returns the
+    // milliseconds to wait before calling it again, or 0 once the panel is
+    // ready. Run it from a timer or event queue so other start-up work
+    // overlaps the panel's delays, and draw nothing before initDone().
+    void     beginST7789(void);
+    uint32_t initStep(void);
+    bool     initDone(void) const { return _initPhase == INIT_DONE; }
+
     void     initB(void);                             // for ST7735B displays
     void     initR(uint8_t options = INITR_GREENTAB); // for ST7735R
     void     setAddrWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
     void     pushColor(uint16_t color),
              pushColors(uint16_t *color, uint32_t len);
 
+    // Raw pixel stream: the bytes go to the panel verbatim in one transfer,
+    // so 'data' must already be in the panel's byte order (big-endian
+    // RGB565, which is what LVGL produces with LV_COLOR_16_SWAP 1).
+    void     pushBytes(const uint8_t *data, size_t len);
+
+    // Non-blocking versions of the above: return as soon as the transfer is
+    // started and call 'done' (from interrupt context) once the last byte
+    // has gone out. The buffer must stay untouched until then. Any other
+    // drawing call waits for the transfer to finish. pushColorsAsync() is
+    // also sent in memory order, unlike pushColors().
+    void     pushBytesAsync(const uint8_t *data, size_t len, Callback<void()> done);
+    void     pushColorsAsync(const uint16_t *color, uint32_t len, Callback<void()> done);
+    bool     busy(void) const { return _asyncBusy; }
+
+    // 12-bit versions of pushBytes()/pushBytesAsync() for the current
+    // window: 'data' holds 'pixels' big-endian RGB565 pixels and is packed
+    // in place to RGB444, 3 bytes for 2 pixels, so its content is lost.
+    // 'dither' applies a 4x4 ordered dither instead of rounding. The panel
+    // is switched to 12-bit COLMOD for the window and back by the next
+    // 16-bit write, so the depth can change from one window to the next.
+    // A window split by the scroll area, or a single pixel, goes out at
+    // 16 bits, with the same 12-bit colours.
+    void     pushBytes444(uint8_t *data, uint32_t pixels, bool dither);
+    void     pushBytes444Async(uint8_t *data, uint32_t pixels, bool dither,
+                               Callback<void()> done);
+
+    // Transaction API, as in Adafruit_SPITFT. CS is held from startWrite()
+    // to the matching endWrite() (calls nest) and DC only toggles between
+    // command and data bytes. The write*() calls below must be bracketed
+    // by startWrite()/endWrite(); the draw*() and fill*() calls do it
+    // themselves.
+    void     startWrite(void);
+    void     endWrite(void);
+    void     writeCommand(uint8_t c);
+    void     spiWrite(uint8_t d);
+    void     writePixel(uint16_t color);
+    void     writePixels(const uint16_t *color, uint32_t len);
+    void     writeColor(uint16_t color, uint32_t len);
+    void     writePixel(int16_t x, int16_t y, uint16_t color);
+    void     writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void     writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void     writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void     writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
     void     fillScreen(uint16_t color);
     void     drawPixel(int16_t x, int16_t y, uint16_t color);
     void     drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
     void     drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
     void     fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+    // Span-batched versions of the Adafruit_GFX shapes: every run of pixels
+    // along a row or column is one window and one burst instead of a window
+    // per pixel, and an opaque bitmap is one window and one pixel stream.
+    // Lines (and so triangles) go through writeLine() above.
+    void     drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void     drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                        int16_t w, int16_t h, uint16_t color);
+    void     drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                        int16_t w, int16_t h, uint16_t color, uint16_t bg);
+    void     drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                        int16_t w, int16_t h, uint16_t color);
+    void     drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                        int16_t w, int16_t h, uint16_t color, uint16_t bg);
+    void     drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                           int16_t w, int16_t h);
+    void     drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                           int16_t w, int16_t h);
+    void     drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                           const uint8_t mask[], int16_t w, int16_t h);
+    void     drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                           uint8_t *mask, int16_t w, int16_t h);
+
+    // 8-bit indexed images: each byte is looked up in 'palette' (RGB565,
+    // 256 entries; NULL reads the bytes as RGB332) while streaming, one
+    // window for the visible part. The expansion into one bounce buffer
+    // overlaps the asynchronous transfer of the other, so a full-screen
+    // GFXcanvas8 takes half the RAM of a GFXcanvas16 and goes out about as
+    // fast. drawCanvas() blits the canvas' buffer as stored, i.e. as drawn
+    // in its rotation 0.
+    void     drawIndexedBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                               const uint16_t *palette, int16_t w, int16_t h);
+    void     drawCanvas(int16_t x, int16_t y, const GFXcanvas8 &canvas);
+
+    // Incremental blits of a canvas kept on screen at (x, y), its buffer as
+    // stored like drawCanvas(): only the dirty rectangles (see GFXdirty)
+    // are sent, one window each, and the dirty state is cleared. A
+    // GFXcanvas1 is drawn in 'color' on 'bg'.
+    void     flushCanvas(GFXcanvas16 &canvas, int16_t x = 0, int16_t y = 0);
+    void     flushCanvas(GFXcanvas8 &canvas, int16_t x = 0, int16_t y = 0);
+    void     flushCanvas(GFXcanvas1 &canvas, uint16_t color, uint16_t bg,
+                         int16_t x = 0, int16_t y = 0);
+
+    // Text, for print() as well: a classic-font glyph with a background
+    // colour is one window and one pixel stream at any text size.
+    // Transparent glyphs, and GFXfont ones, which never have a background,
+    // send each run of set pixels along a glyph row as one rectangle.
+    using    Adafruit_GFX::drawChar;
+    void     drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                      uint16_t bg, uint8_t size_x, uint8_t size_y);
     void     invertDisplay(boolean i);
+    void     setFrequency(uint32_t hz);
+    void     setFillBuffer(uint8_t *buf, size_t len);
+
+    // Hardware vertical scrolling (ST7789, rotation 0). Rows [top, top +
+    // height) become a scroll area whose content scroll() moves on the panel
+    // itself without resending it (positive dy moves it down). Drawing keeps
+    // using screen coordinates: setAddrWindow() maps rows into the shifted
+    // memory and splits windows that cross the wrap. Changing the area, or
+    // switching it off with height 0, puts the memory back in place without
+    // moving any pixels, so what was in the old area has to be redrawn.
+    bool     setScrollArea(int16_t top, int16_t height);
+    void     scroll(int16_t dy);
+
+    // Low-power modes for screens that rarely change. setPartialArea()
+    // drives only rows [top, top + height) (PTLAR/PTLON); height 0 goes
+    // back to normal mode (NORON). Only rotation 0 has rows running along
+    // the panel's lines, so the other rotations take an area covering the
+    // whole screen only. setIdleMode() drops to 8 colours (IDMON/IDMOFF).
+    // setLowFrameRate() sets the refresh rate of partial and idle mode
+    // as a divider (1, 2, 4 or 8) of the normal one: FRCTRL1 on the
+    // ST7789; the ST7735 (FRMCTR2/3) only gets down to about half.
+    bool     setPartialArea(int16_t top, int16_t height);
+    void     setIdleMode(bool idle);
+    void     setLowFrameRate(uint8_t div);
+
+    const ST7735WindowStats &windowStats(void) const;
+    void     resetWindowStats(void);
 
     void     setRotation(uint8_t r);
     uint16_t Color565(uint8_t r, uint8_t g, uint8_t b);
 
 private:
     uint8_t  tabcolor;
-    void     spiwrite(uint8_t),
-             writecommand(uint8_t c),
+    void     writecommand(uint8_t c),
              writedata(uint8_t d),
+             writeBytes(const uint8_t *data, uint32_t len),
+             dataMode(void),
              commandList(uint8_t *addr),
-             commonInit(uint8_t *cmdList);
+             commonInit(uint8_t *cmdList),
+             commonSetup(void),
+             writeRam(const uint8_t *data, uint32_t len),
+             openWindow(uint16_t xs, uint16_t xe, uint16_t ys),
+             nextSegment(void),
+             scrollCommands(uint16_t tfa, uint16_t vsa, uint16_t vsp),
+             colmod16(void),
+             asyncStart(const uint8_t *data, size_t len, uint32_t pixels,
+                        Callback<void()> done),
+             waitIdle(void),
+             asyncNext(void),
+             asyncEvent(int event),
+             circleSpans(int16_t x0, int16_t y0, int16_t a, int16_t b,
+                         int16_t y, uint16_t color),
+             writeBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                         int16_t w, int16_t h, uint16_t color, uint16_t bg,
+                         bool opaque),
+             writeRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap,
+                            const uint8_t *mask, int16_t w, int16_t h),
+             writeIndexed(const uint8_t *bitmap, int16_t stride,
+                          const uint16_t *palette, int16_t w, int16_t h),
+             glyphRuns(int16_t x, int16_t y, const uint8_t *bits, uint16_t stride,
+                       uint8_t w, uint8_t h, uint8_t size_x, uint8_t size_y,
+                       uint16_t color),
+             glyphBlit(int16_t x, int16_t y, const uint8_t *bits, uint16_t stride,
+                       uint8_t w, uint8_t h, uint8_t size_x, uint8_t size_y,
+                       uint16_t color, uint16_t bg),
+             flushDirty(GFXdirty &dirty, int16_t x, int16_t y,
+                        const uint8_t *buf, uint8_t depth, int16_t stride,
+                        const uint16_t *colors);
+    uint16_t commandStep(uint8_t *&addr);
+    bool     open444(uint32_t pixels);
+    uint32_t pack444(uint8_t *data, uint32_t pixels, bool dither);
+    void     widen444(uint8_t *data, uint32_t pixels, bool dither);
 
     uint8_t  colstart, rowstart; // some displays need this changed
 
@@ -160,6 +372,51 @@ private:
     DigitalOut _rs;         // register/date select
     DigitalOut _rst;        // does 3310 LCD_RST
     uint16_t _init_width, _init_height;
+    uint32_t _freq;
+    uint8_t  _burst[ST7735_BURST_BYTES]; // staging for buffered SPI writes
+    uint8_t *_bounce;               // drawIndexedBitmap() lines, see ST7735_BOUNCE_BYTES
+
+    uint8_t *_fill;                 // solid-fill pattern buffer
+    uint32_t _fillLen;              // its size in bytes
+    uint32_t _fillPixels;           // pixels of _fillColor prepared in it
+    uint16_t _fillColor;
+    bool     _fillValid;
+
+    const char *_asyncBuf;          // next byte of the running async push
+    uint32_t    _asyncLeft;         // bytes still to send
+    Callback<void()> _asyncDone;
+    volatile bool    _asyncBusy;
+
+    volatile uint8_t _txn;          // startWrite() nesting depth
+    bool     _dc;                   // true while DC selects data
+
+    uint16_t _winXs, _winXe, _winYs; // window last sent, controller coords
+    bool     _winValid;
+    bool     _ramwr;                // RAMWR still running, nothing since
+    uint32_t _ramPixels;            // pixels written since RAMWR
+    uint16_t _curYs;                // first row of the window being written
+    bool     _bits12;               // COLMOD is 12-bit, see pushBytes444()
+    ST7735WindowStats _winStats;
+
+    uint16_t _gramRows;             // controller memory rows, 0: no scrolling
+    int16_t  _scrollTop, _scrollH;  // scroll area in screen rows, 0: none
+    int16_t  _scrollOff;            // memory row shown at the top of the area
+
+    // A window crossing the scroll wrap is sent as several row segments
+    uint16_t _segXs, _segXe;        // columns, controller coords
+    uint16_t _segYe;                // last row of an unsplit window
+    uint16_t _segStart[4], _segRows[4];
+    uint8_t  _segCount, _segNext;
+    uint32_t _segLeft;              // bytes until the next segment
+
+    bool     _st7789;               // ST7789 command set, see setLowFrameRate()
+    bool     _partial;              // partial mode on
+
+    // beginST7789()/initStep() progress
+    enum { INIT_RESET, INIT_WAKE, INIT_COMMANDS, INIT_DONE };
+    uint8_t *_initCmd;              // next command of the table
+    uint8_t  _initLeft;             // commands still to send
+    uint8_t  _initPhase;
 };
 
 #endif
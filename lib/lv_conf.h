@@ -50,6 +50,19 @@
  * Can be changed in the display driver (`lv_disp_drv_t`).*/
 #define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
 
+/* 1: Refresh a display as soon as an area is invalidated on it, but at most
+ * every LV_REFR_MIN_PERIOD ms, instead of every LV_DISP_DEF_REFR_PERIOD ms.
+ * A refresh overrunning the period doubles it, up to LV_REFR_MAX_PERIOD.
+ * With nothing invalidated and no animation no task runs: sleep
+ * `lv_task_get_time_till_next()` ms between the calls of `lv_task_handler()`
+ * and end the sleep from the display driver's `wake_cb`, which is called
+ * when an invalidation schedules a refresh. */
+#define LV_USE_REFR_PACING           1
+#if LV_USE_REFR_PACING
+#define LV_REFR_MIN_PERIOD           20      /*[ms]*/
+#define LV_REFR_MAX_PERIOD           250     /*[ms]*/
+#endif
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -144,6 +157,61 @@ typedef void * lv_group_user_data_t;
 /* 1: Enable GPU interface*/
 #define LV_USE_GPU              0
 
+/* 1: Let the display driver move the content of full-width pages itself
+ * when they scroll vertically, so only the newly exposed rows are redrawn
+ * (needs `scroll_cb` in the display driver)*/
+#define LV_USE_HW_SCROLL        1
+
+/* 1: Keep invalidated areas as a bitmap of LV_INV_TILE_SIZE x LV_INV_TILE_SIZE
+ * tiles instead of a list: marking is constant time per tile row and the areas
+ * refreshed are whole tiles. The display driver's `scroll_cb` is not used then. */
+#define LV_INV_TILES            0
+#if LV_INV_TILES
+#define LV_INV_TILE_SIZE        16
+#endif
+
+/* 1: Walk the objects once per refreshed area: what they draw is recorded in a
+ * list of LV_DRAW_LIST_SIZE bytes and replayed for every VDB strip. An area
+ * whose drawing doesn't fit is drawn the usual way. */
+#define LV_USE_DRAW_LIST        1
+#if LV_USE_DRAW_LIST
+#define LV_DRAW_LIST_SIZE       (4U * 1024U)
+#endif
+
+/* 1: Before drawing, find the areas objects cover with opaque pixels (up to
+ * LV_OCCLUDER_MAX of the largest) and don't draw what objects drawn earlier
+ * have under them: hidden objects are skipped, partly hidden ones get a
+ * smaller area. `px_drawn` and `px_culled` of the display show the effect. */
+#define LV_USE_OCCLUSION        1
+#if LV_USE_OCCLUSION
+#define LV_OCCLUDER_MAX         8
+#endif
+
+/* 1: Keep a hash of the last LV_STRIP_HASH_CNT strips flushed and don't flush
+ * a strip whose pixels hash the same as the last one flushed to its area.
+ * Call `lv_disp_clean_strip_hash()` after drawing to the panel directly. */
+#define LV_USE_STRIP_HASH       1
+#if LV_USE_STRIP_HASH
+#define LV_STRIP_HASH_CNT       32
+#endif
+
+/* 1: Flush only the columns of a strip which changed since they were flushed:
+ * a signature is kept for every row and LV_COL_DELTA_W columns of the display
+ * and the changed column groups are flushed as separate windows. Unchanged
+ * columns between two windows are flushed too when sending them costs less
+ * than LV_COL_DELTA_WIN_COST pixels, the price of starting a window.
+ * Call `lv_disp_clean_col_sig()` after drawing to the panel directly.
+ * The signatures are 32-bit hashes: a changed group keeping its signature,
+ * and so its stale pixels, is about a 1 in 4 billion chance per change.
+ * Each display's `lv_disp_t` grows by 4 bytes per LV_COL_DELTA_W columns for
+ * every line of the longer side, plus 4 bytes per line, from LV_MEM_SIZE:
+ * about 15 KB for a 240-pixel side and 16-column groups. */
+#define LV_USE_COL_DELTA        0
+#if LV_USE_COL_DELTA
+#define LV_COL_DELTA_W          16
+#define LV_COL_DELTA_WIN_COST   32
+#endif
+
 /* 1: Enable file system (might be required for images */
 #define LV_USE_FILESYSTEM       1
 #if LV_USE_FILESYSTEM
@@ -199,10 +267,12 @@ typedef void * lv_img_decoder_user_data_t;
 
 /* 1: use a custom tick source.
  * It removes the need to manually update the tick with `lv_tick_inc`) */
-#define LV_TICK_CUSTOM     0
+#define LV_TICK_CUSTOM     1
 #if LV_TICK_CUSTOM == 1
-#define LV_TICK_CUSTOM_INCLUDE  "something.h"       /*Header for the sys time function*/
-#define LV_TICK_CUSTOM_SYS_TIME_EXPR (millis())     /*Expression evaluating to current systime in ms*/
+#define LV_TICK_CUSTOM_INCLUDE  "hal/us_ticker_api.h"       /*Header for the sys time function*/
+/*mbed's 64-bit microsecond ticker: no interrupt wakes the CPU to count ms,
+  and the 32-bit microseconds' wrap every 71 minutes doesn't show*/
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR ((uint32_t)(ticker_read_us(get_us_ticker_data()) / 1000))
 #endif   /*LV_TICK_CUSTOM*/
 
 typedef void * lv_disp_drv_user_data_t;             /*Type of user data in the display driver*/
@@ -228,6 +298,22 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
 #  define LV_LOG_PRINTF   0
 #endif  /*LV_USE_LOG*/
 
+/*=====================
+ * Profiler settings
+ *====================*/
+
+/* 1: Profile the refreshes: joining, areas and strips, design time per
+ * object type, waiting for and calling `flush_cb`, bytes flushed.
+ * The last LV_PROF_FRAMES refreshes are kept, with at most LV_PROF_TYPES
+ * object types each; `lv_prof_dump()` prints them. */
+#define LV_USE_PROF     0
+#if LV_USE_PROF
+#  define LV_PROF_FRAMES          8
+#  define LV_PROF_TYPES           8
+#  define LV_PROF_TIME_INCLUDE    "hal/us_ticker_api.h" /*Header for the time function*/
+#  define LV_PROF_TIME_EXPR       (us_ticker_read())    /*Expression evaluating to a time in us*/
+#endif  /*LV_USE_PROF*/
+
 /*================
  *  THEME USAGE
  *================*/
@@ -28,6 +28,7 @@ extern "C" {
 
 #include "src/lv_core/lv_refr.h"
 #include "src/lv_core/lv_disp.h"
+#include "src/lv_core/lv_prof.h"
 
 #include "src/lv_themes/lv_theme.h"
 
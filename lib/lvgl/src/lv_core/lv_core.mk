@@ -2,6 +2,7 @@ CSRCS += lv_group.c
 CSRCS += lv_indev.c
 CSRCS += lv_disp.c
 CSRCS += lv_obj.c
+CSRCS += lv_prof.c
 CSRCS += lv_refr.c
 CSRCS += lv_style.c
 
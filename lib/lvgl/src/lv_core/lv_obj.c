@@ -652,6 +652,15 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     /*Send a signal to the parent too*/
     par->signal_cb(par, LV_SIGNAL_CHILD_CHG, obj);
 
+#if LV_USE_HW_SCROLL
+    /*The display has moved the content itself (see `lv_refr_hw_scroll`)*/
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp->hw_scroll_skip == obj) {
+        disp->hw_scroll_skip = NULL;
+        return;
+    }
+#endif
+
     /*Invalidate the new area*/
     lv_obj_invalidate(obj);
 }
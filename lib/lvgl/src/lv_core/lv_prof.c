@@ -0,0 +1,175 @@
+/**
+ * @file lv_prof.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <string.h>
+#include "lv_prof.h"
+#include "../lv_hal/lv_hal_tick.h"
+
+#if LV_USE_PROF
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_prof_frame_t frames[LV_PROF_FRAMES + 1]; /*The kept ones and the one being recorded*/
+static uint16_t frame_act;                         /*The one being recorded*/
+static uint16_t frame_cnt;                         /*Kept ones, before `frame_act`*/
+static uint32_t frame_start_time;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Start the profile of a refresh. Called by the refresh task.
+ */
+void lv_prof_frame_start(void)
+{
+    lv_prof_frame_t * f = &frames[frame_act];
+    memset(f, 0, sizeof(lv_prof_frame_t));
+    f->start         = lv_tick_get();
+    frame_start_time = (LV_PROF_TIME_EXPR);
+}
+
+/**
+ * Finish the profile of the refresh
+ * @param keep true: add it to the kept profiles; false: drop it (there was nothing to refresh)
+ */
+void lv_prof_frame_end(bool keep)
+{
+    if(keep == false) return;
+
+    frames[frame_act].time = (uint32_t)(LV_PROF_TIME_EXPR) - frame_start_time;
+
+    frame_act++;
+    if(frame_act > LV_PROF_FRAMES) frame_act = 0;
+    if(frame_cnt < LV_PROF_FRAMES) frame_cnt++;
+}
+
+/**
+ * Get the profile of the refresh in progress to add to it
+ * @return pointer to the profile
+ */
+lv_prof_frame_t * lv_prof_get_act(void)
+{
+    return &frames[frame_act];
+}
+
+/**
+ * Add the time of a design function call to the design time of the object's type
+ * @param obj pointer to the object drawn
+ * @param time [us] time of the call
+ */
+void lv_prof_add_design(const lv_obj_t * obj, uint32_t time)
+{
+    lv_prof_frame_t * f = &frames[frame_act];
+    f->design_time += time;
+
+    uint8_t i;
+    for(i = 0; i < f->design_cnt; i++) {
+        if(f->design[i].design_cb == obj->design_cb) break;
+    }
+
+    if(i == f->design_cnt) {
+        if(f->design_cnt >= LV_PROF_TYPES) return; /*Counted in `design_time` only*/
+
+        lv_obj_type_t type;
+        lv_obj_get_type((lv_obj_t *)obj, &type);
+        f->design[i].design_cb = obj->design_cb;
+        f->design[i].type      = type.type[0];
+        f->design_cnt++;
+    }
+
+    f->design[i].time += time;
+    f->design[i].calls++;
+}
+
+/**
+ * Get the number of kept profiles
+ * @return 0..`LV_PROF_FRAMES`
+ */
+uint16_t lv_prof_get_cnt(void)
+{
+    return frame_cnt;
+}
+
+/**
+ * Get a kept profile
+ * @param i 0: the latest refresh, 1: the one before, ...
+ * @return pointer to the profile or NULL if `i` is not less than `lv_prof_get_cnt()`
+ */
+const lv_prof_frame_t * lv_prof_get_frame(uint16_t i)
+{
+    if(i >= frame_cnt) return NULL;
+
+    int32_t f = (int32_t)frame_act - 1 - i;
+    if(f < 0) f += LV_PROF_FRAMES + 1;
+
+    return &frames[f];
+}
+
+/**
+ * Drop the kept profiles
+ */
+void lv_prof_clear(void)
+{
+    frame_cnt = 0;
+}
+
+/**
+ * Print the kept profiles, the oldest first, a line at a time
+ * @param print_cb function printing a line
+ */
+void lv_prof_dump(lv_prof_print_cb_t print_cb)
+{
+    char line[128];
+    uint16_t i = frame_cnt;
+    while(i > 0) {
+        i--;
+        const lv_prof_frame_t * f = lv_prof_get_frame(i);
+
+        snprintf(line, sizeof(line), "refr @%lu ms: %lu us, join %lu us, %u areas in %u strips",
+                 (unsigned long)f->start, (unsigned long)f->time, (unsigned long)f->join_time, f->areas, f->strips);
+        print_cb(line);
+
+        snprintf(line, sizeof(line),
+                 "  design %lu us, draw list %lu us, wait %lu us, flush_cb %lu us, %u flushes %lu bytes",
+                 (unsigned long)f->design_time, (unsigned long)f->play_time, (unsigned long)f->wait_time,
+                 (unsigned long)f->flush_time, f->flushes, (unsigned long)f->flush_bytes);
+        print_cb(line);
+
+        uint8_t t;
+        for(t = 0; t < f->design_cnt; t++) {
+            snprintf(line, sizeof(line), "  %-12s %6lu us in %u calls", f->design[t].type,
+                     (unsigned long)f->design[t].time, f->design[t].calls);
+            print_cb(line);
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_USE_PROF*/
@@ -0,0 +1,144 @@
+/**
+ * @file lv_prof.h
+ * Profile of the last refreshes: where their time went
+ */
+
+#ifndef LV_PROF_H
+#define LV_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_conf.h"
+#else
+#include "../../../lv_conf.h"
+#endif
+
+#include "lv_obj.h"
+
+#if LV_USE_PROF
+
+#include LV_PROF_TIME_INCLUDE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Time spent in the design function of one object type*/
+typedef struct
+{
+    lv_design_cb_t design_cb; /**< The type's design function*/
+    const char * type;        /**< Name of the type, e.g. "lv_btn"*/
+    uint32_t time;            /**< [us] In the design function*/
+    uint16_t calls;           /**< Calls of the design function*/
+} lv_prof_design_t;
+
+/** Profile of a refresh*/
+typedef struct
+{
+    uint32_t start;       /**< [ms] Tick when the refresh started*/
+    uint32_t time;        /**< [us] The whole refresh*/
+    uint32_t join_time;   /**< [us] Joining the invalidated areas*/
+    uint32_t design_time; /**< [us] In the design functions of the objects*/
+    uint32_t play_time;   /**< [us] Replaying the draw list*/
+    uint32_t wait_time;   /**< [us] Waiting for a VDB buffer to be flushed*/
+    uint32_t flush_time;  /**< [us] In `flush_cb`*/
+    uint32_t flush_bytes; /**< Bytes given to `flush_cb`*/
+    uint16_t flushes;     /**< Calls of `flush_cb`*/
+    uint16_t areas;       /**< Areas refreshed after joining*/
+    uint16_t strips;      /**< VDB strips they were drawn in*/
+    uint8_t design_cnt;   /**< Used entries in `design`*/
+    lv_prof_design_t design[LV_PROF_TYPES]; /**< Design time by object type (the first `LV_PROF_TYPES` types)*/
+} lv_prof_frame_t;
+
+/**
+ * Prints a line of `lv_prof_dump()`, without a line ending
+ */
+typedef void (*lv_prof_print_cb_t)(const char * line);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start the profile of a refresh. Called by the refresh task.
+ */
+void lv_prof_frame_start(void);
+
+/**
+ * Finish the profile of the refresh
+ * @param keep true: add it to the kept profiles; false: drop it (there was nothing to refresh)
+ */
+void lv_prof_frame_end(bool keep);
+
+/**
+ * Get the profile of the refresh in progress to add to it
+ * @return pointer to the profile
+ */
+lv_prof_frame_t * lv_prof_get_act(void);
+
+/**
+ * Add the time of a design function call to the design time of the object's type
+ * @param obj pointer to the object drawn
+ * @param time [us] time of the call
+ */
+void lv_prof_add_design(const lv_obj_t * obj, uint32_t time);
+
+/**
+ * Get the number of kept profiles
+ * @return 0..`LV_PROF_FRAMES`
+ */
+uint16_t lv_prof_get_cnt(void);
+
+/**
+ * Get a kept profile
+ * @param i 0: the latest refresh, 1: the one before, ...
+ * @return pointer to the profile or NULL if `i` is not less than `lv_prof_get_cnt()`
+ */
+const lv_prof_frame_t * lv_prof_get_frame(uint16_t i);
+
+/**
+ * Drop the kept profiles
+ */
+void lv_prof_clear(void);
+
+/**
+ * Print the kept profiles, the oldest first, a line at a time
+ * @param print_cb function printing a line
+ */
+void lv_prof_dump(lv_prof_print_cb_t print_cb);
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*Measure the time since `LV_PROF_START(t)` into a field of the refresh's profile*/
+#define LV_PROF_START(t) uint32_t t = (LV_PROF_TIME_EXPR)
+#define LV_PROF_ADD_TIME(field, t) lv_prof_get_act()->field += (uint32_t)(LV_PROF_TIME_EXPR) - (t)
+#define LV_PROF_ADD(field, n) lv_prof_get_act()->field += (n)
+#define LV_PROF_ADD_DESIGN(obj, t) lv_prof_add_design(obj, (uint32_t)(LV_PROF_TIME_EXPR) - (t))
+
+#else /*LV_USE_PROF*/
+
+/*Do nothing if `LV_USE_PROF 0`*/
+#define LV_PROF_START(t)
+#define LV_PROF_ADD_TIME(field, t) {;}
+#define LV_PROF_ADD(field, n) {;}
+#define LV_PROF_ADD_DESIGN(obj, t) {;}
+
+#endif /*LV_USE_PROF*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PROF_H*/
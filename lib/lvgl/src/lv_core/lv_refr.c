@@ -9,10 +9,12 @@
 #include <stddef.h>
 #include "lv_refr.h"
 #include "lv_disp.h"
+#include "lv_prof.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_gc.h"
 #include "../lv_draw/lv_draw.h"
 
@@ -26,27 +28,72 @@
 /* Draw translucent random colored areas on the invalidated (redrawn) areas*/
 #define MASK_AREA_DEBUG 0
 
+/*Most parts an object is drawn in around the areas objects drawn later cover*/
+#define LV_REFR_CULL_PARTS 8
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_OCCLUSION
+/*An area an object covers with opaque pixels*/
+typedef struct
+{
+    lv_area_t area;
+    uint16_t order; /*The object's place in the drawing order*/
+} lv_refr_occluder_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static uint32_t lv_refr_area_cost(lv_disp_t * disp, const lv_area_t * area_p);
+static void lv_refr_save_area(lv_disp_t * disp, const lv_area_t * area_p);
+static void lv_refr_make_room(lv_disp_t * disp, const lv_area_t * area_p);
+#if LV_INV_TILES
+static void lv_refr_tiles_to_areas(void);
+#endif
 static void lv_refr_join_area(void);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
+#if LV_USE_DRAW_LIST
+static bool lv_refr_area_record(const lv_area_t * area_p);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+static void lv_refr_scr_and_layers(const lv_area_t * mask_p);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
+#if LV_USE_OCCLUSION
+static void lv_refr_add_occluder(lv_obj_t * obj, const lv_area_t * mask_p);
+static uint8_t lv_refr_cull(uint16_t order, const lv_area_t * area_p, lv_area_t * parts);
+static bool lv_refr_trim(uint16_t order, lv_area_t * area_p);
+#endif
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
 static void lv_refr_vdb_flush(void);
+#if LV_USE_REFR_PACING
+static void lv_refr_schedule(lv_disp_t * disp);
+static void lv_refr_pace(uint32_t start, bool refreshed);
+#endif
+#if LV_USE_STRIP_HASH
+static bool lv_refr_strip_unchanged(void);
+#endif
+#if LV_USE_COL_DELTA
+static bool lv_refr_col_delta_flush(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+#if LV_USE_DRAW_LIST
+static bool area_recorded; /*The strips of the area being refreshed are drawn from the draw list*/
+#endif
+#if LV_USE_OCCLUSION
+static lv_refr_occluder_t occluders[LV_OCCLUDER_MAX];
+static uint16_t occluder_cnt;
+static uint16_t draw_order;  /*Objects drawn so far in the walk*/
+static bool occluder_walk; /*The walk only looks for occluders, nothing is drawn*/
+#endif
 
 /**********************
  *      MACROS
@@ -99,6 +146,9 @@ void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+#if LV_INV_TILES
+        memset(disp->inv_tiles, 0, sizeof(disp->inv_tiles));
+#endif
         return;
     }
 
@@ -117,22 +167,119 @@ void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(suc != false) {
         if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp->driver, &com_area);
 
-        /*Save only if this area is not in one of the saved areas*/
-        uint16_t i;
-        for(i = 0; i < disp->inv_p; i++) {
-            if(lv_area_is_in(&com_area, &disp->inv_areas[i]) != false) return;
+#if LV_INV_TILES
+        /*Mark the tiles; the refresh turns them into areas*/
+        lv_coord_t c1 = com_area.x1 / LV_INV_TILE_SIZE;
+        lv_coord_t c2 = com_area.x2 / LV_INV_TILE_SIZE;
+        lv_coord_t r;
+        uint32_t mask = ((2UL << c2) - 1) & ~((1UL << c1) - 1);
+        for(r = com_area.y1 / LV_INV_TILE_SIZE; r <= com_area.y2 / LV_INV_TILE_SIZE; r++) {
+            disp->inv_tiles[r] |= mask;
         }
+#else
+        lv_refr_save_area(disp, &com_area);
+#endif
+#if LV_USE_REFR_PACING
+        lv_refr_schedule(disp);
+#endif
+    }
+}
 
-        /*Save the area*/
-        if(disp->inv_p < LV_INV_BUF_SIZE) {
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
-        } else { /*If no place for the area add the screen*/
-            disp->inv_p = 0;
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
-        }
-        disp->inv_p++;
+#if LV_USE_HW_SCROLL
+/**
+ * Let the display move a band of full-width rows itself instead of redrawing it.
+ * To be called from `LV_SIGNAL_CORD_CHG` of an object moved by `lv_obj_set_pos` (e.g. a page's
+ * scrollable), while the invalidation of its old area is still the last one saved.
+ * @param disp pointer to the display
+ * @param band the rows to move (`x1` and `x2` are ignored, the whole width moves)
+ * @param dy move the rows by this much (positive: down)
+ * @param old_area the area invalidated for the object's old position
+ * @return true: the rows were moved, the old area's invalidation was replaced by the rows the move
+ *         exposed and the caller must skip the invalidation of the new area;
+ *         false: nothing changed, redraw as usual
+ */
+bool lv_refr_hw_scroll(lv_disp_t * disp, const lv_area_t * band, lv_coord_t dy, const lv_area_t * old_area)
+{
+#if LV_INV_TILES
+    /*The old area's tiles can't be told apart from others to take its invalidation back*/
+    (void)disp;
+    (void)band;
+    (void)dy;
+    (void)old_area;
+    return false;
+#else
+    if(disp->driver.scroll_cb == NULL || dy == 0) return false;
+
+    lv_area_t scr_area;
+    lv_area_set(&scr_area, 0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1);
+
+    lv_area_t b;
+    lv_area_set(&b, scr_area.x1, band->y1, scr_area.x2, band->y2);
+    if(lv_area_intersect(&b, &b, &scr_area) == false) return false;
+    if(LV_MATH_ABS(dy) >= lv_area_get_height(&b)) return false;
+
+    /*The old area has to be the last one saved (as `lv_inv_area` saved it) and nothing else may
+     * wait in the band: it would be drawn at its old place after the move*/
+    lv_area_t old;
+    if(disp->inv_p == 0) return false;
+    if(lv_area_intersect(&old, old_area, &scr_area) == false) return false;
+    if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp->driver, &old);
+
+    const lv_area_t * last = &disp->inv_areas[disp->inv_p - 1];
+    if(last->x1 != old.x1 || last->y1 != old.y1 || last->x2 != old.x2 || last->y2 != old.y2) return false;
+
+    lv_area_t tmp;
+    uint16_t i;
+    for(i = 0; i < disp->inv_p - 1; i++) {
+        if(lv_area_intersect(&tmp, &disp->inv_areas[i], &b)) return false;
     }
+
+    /*Another band was moved before: have it put back and redraw everything as usual this time*/
+    if(disp->hw_scroll_band.y1 <= disp->hw_scroll_band.y2 &&
+       (disp->hw_scroll_band.y1 != b.y1 || disp->hw_scroll_band.y2 != b.y2)) {
+        disp->driver.scroll_cb(&disp->driver, NULL, 0);
+#if LV_USE_STRIP_HASH
+        lv_disp_clean_strip_hash(disp);
+#endif
+#if LV_USE_COL_DELTA
+        lv_disp_clean_col_sig(disp);
+#endif
+        lv_inv_area(disp, &disp->hw_scroll_band);
+        lv_area_set(&disp->hw_scroll_band, 0, 0, -1, -1);
+        return false;
+    }
+
+    if(disp->driver.scroll_cb(&disp->driver, &b, dy) == false) return false;
+    lv_area_copy(&disp->hw_scroll_band, &b);
+#if LV_USE_STRIP_HASH
+    lv_disp_clean_strip_hash(disp);
+#endif
+#if LV_USE_COL_DELTA
+    lv_disp_clean_col_sig(disp);
+#endif
+
+    lv_disp_pop_from_inv_buf(disp, 1);
+
+    /*The rows of the old area above and below the band didn't move*/
+    if(old.y1 < b.y1) {
+        lv_area_set(&tmp, old.x1, old.y1, old.x2, LV_MATH_MIN(old.y2, b.y1 - 1));
+        lv_inv_area(disp, &tmp);
+    }
+    if(old.y2 > b.y2) {
+        lv_area_set(&tmp, old.x1, LV_MATH_MAX(old.y1, b.y2 + 1), old.x2, old.y2);
+        lv_inv_area(disp, &tmp);
+    }
+
+    /*The rows the move exposed*/
+    lv_area_copy(&tmp, &b);
+    if(dy > 0) tmp.y2 = b.y1 + dy - 1;
+    else tmp.y1 = b.y2 + dy + 1;
+    lv_inv_area(disp, &tmp);
+
+    return true;
+#endif
 }
+#endif
 
 /**
  * Get the display which is being refreshed
@@ -166,10 +313,25 @@ void lv_disp_refr_task(lv_task_t * task)
 
     disp_refr = task->user_data;
 
+#if LV_USE_PROF
+    lv_prof_frame_start();
+#endif
+    LV_PROF_START(prof_join);
+
+#if LV_INV_TILES
+    lv_refr_tiles_to_areas();
+#endif
+
     lv_refr_join_area();
 
+    LV_PROF_ADD_TIME(join_time, prof_join);
+
     lv_refr_areas();
 
+#if LV_USE_REFR_PACING || LV_USE_PROF
+    bool refreshed = disp_refr->inv_p != 0;
+#endif
+
     /*If refresh happened ...*/
     if(disp_refr->inv_p != 0) {
         /*In true double buffered mode copy the refreshed areas to the new VDB to keep it up to
@@ -183,8 +345,10 @@ void lv_disp_refr_task(lv_task_t * task)
             /* With true double buffering the flushing should be only the address change of the
              * current frame buffer. Wait until the address change is ready and copy the changed
              * content to the other frame buffer (new active VDB) to keep the buffers synchronized*/
+            LV_PROF_START(prof_wait);
             while(vdb->flushing)
                 ;
+            LV_PROF_ADD_TIME(wait_time, prof_wait);
 
             uint8_t * buf_act = (uint8_t *)vdb->buf_act;
             uint8_t * buf_ina = (uint8_t *)vdb->buf_act == vdb->buf1 ? vdb->buf2 : vdb->buf1;
@@ -219,6 +383,13 @@ void lv_disp_refr_task(lv_task_t * task)
 
     lv_draw_free_buf();
 
+#if LV_USE_REFR_PACING
+    lv_refr_pace(start, refreshed);
+#endif
+#if LV_USE_PROF
+    lv_prof_frame_end(refreshed);
+#endif
+
     LV_LOG_TRACE("lv_refr_task: ready");
 }
 
@@ -226,40 +397,239 @@ void lv_disp_refr_task(lv_task_t * task)
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_USE_REFR_PACING
 /**
- * Join the areas which has got common parts
+ * Make the refresh task of a display run once an area is invalidated on it: right away if its
+ * refresh period has passed since the last refresh, else when it passes. The driver's `wake_cb`
+ * is told.
+ * @param disp pointer to the display
  */
-static void lv_refr_join_area(void)
+static void lv_refr_schedule(lv_disp_t * disp)
 {
-    uint32_t join_from;
-    uint32_t join_in;
+    lv_task_t * task = disp->refr_task;
+    if(task == NULL || task->period != LV_TASK_PERIOD_NEVER) return; /*Not created yet or already scheduled*/
+
+    uint32_t elaps = lv_tick_elaps(disp->refr_last);
+    lv_task_set_period(task, elaps >= disp->refr_period ? 0 : disp->refr_period - elaps);
+    lv_task_reset(task);
+
+    if(disp->driver.wake_cb) disp->driver.wake_cb(&disp->driver);
+}
+
+/**
+ * Adapt the refresh period of the display being refreshed to how long the refresh took, then let
+ * its refresh task sleep until an area is invalidated again
+ * @param start start time of the refresh
+ * @param refreshed true: areas were refreshed; false: there was nothing to refresh
+ */
+static void lv_refr_pace(uint32_t start, bool refreshed)
+{
+    if(refreshed) {
+        uint32_t elaps = lv_tick_elaps(start);
+        if(elaps > disp_refr->refr_period) {
+            disp_refr->refr_period = LV_MATH_MIN(disp_refr->refr_period * 2, LV_REFR_MAX_PERIOD);
+        } else if(elaps * 2 < disp_refr->refr_period) {
+            /*Well in time: come back towards the shortest period*/
+            disp_refr->refr_period -= disp_refr->refr_period / 4;
+            if(disp_refr->refr_period < LV_REFR_MIN_PERIOD) disp_refr->refr_period = LV_REFR_MIN_PERIOD;
+        }
+        disp_refr->refr_last = start;
+    }
+
+    lv_task_set_period(disp_refr->refr_task, LV_TASK_PERIOD_NEVER);
+
+#if LV_INV_TILES
+    /*Tiles marked while refreshing are still to be refreshed*/
+    uint16_t r;
+    for(r = 0; r < LV_INV_TILE_ROWS; r++) {
+        if(disp_refr->inv_tiles[r] != 0) {
+            lv_refr_schedule(disp_refr);
+            break;
+        }
+    }
+#endif
+}
+#endif
+
+/**
+ * Cost of refreshing an area: the driver's own estimate, or its pixels plus `area_cost` for every
+ * VDB strip it is drawn and flushed in
+ * @param disp pointer to the display
+ * @param area_p pointer to an area
+ * @return the cost
+ */
+static uint32_t lv_refr_area_cost(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    lv_disp_drv_t * drv = &disp->driver;
+    if(drv->area_cost_cb) return drv->area_cost_cb(drv, area_p);
+
+    uint32_t strips = 1;
+    if(lv_disp_is_true_double_buf(disp) == false) {
+        uint32_t max_row = lv_disp_get_buf(disp)->size / lv_area_get_width(area_p);
+        if(max_row != 0) strips = (lv_area_get_height(area_p) + max_row - 1) / max_row;
+    }
+
+    return lv_area_get_size(area_p) + drv->area_cost * strips;
+}
+
+/**
+ * Save an invalidated area unless a saved one covers it already
+ * @param disp pointer to the display
+ * @param area_p the area, on the screen and rounded
+ */
+static void lv_refr_save_area(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(lv_area_is_in(area_p, &disp->inv_areas[i]) != false) return;
+    }
+
+    if(disp->inv_p < LV_INV_BUF_SIZE) {
+        lv_area_copy(&disp->inv_areas[disp->inv_p], area_p);
+        disp->inv_p++;
+    } else { /*If no place for the area join the two cheapest to join*/
+        disp->inv_overflows++;
+        lv_refr_make_room(disp, area_p);
+    }
+}
+
+#if LV_INV_TILES
+/**
+ * Turn the dirty tiles into areas to refresh, each as wide as the run of dirty tiles starting at
+ * the first one left and then as tall as the rows below have all its tiles dirty
+ */
+static void lv_refr_tiles_to_areas(void)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(disp_refr);
+    lv_coord_t vres = lv_disp_get_ver_res(disp_refr);
+    uint32_t * tiles = disp_refr->inv_tiles;
+    uint16_t r;
+
+    for(r = 0; r < LV_INV_TILE_ROWS; r++) {
+        while(tiles[r] != 0) {
+            uint16_t c1 = 0;
+            while((tiles[r] & (1UL << c1)) == 0) c1++;
+            uint16_t c2 = c1;
+            while(c2 + 1 < LV_INV_TILE_COLS && (tiles[r] & (1UL << (c2 + 1)))) c2++;
+
+            uint32_t mask = ((2UL << c2) - 1) & ~((1UL << c1) - 1);
+            uint16_t r2   = r;
+            while(r2 + 1 < LV_INV_TILE_ROWS && (tiles[r2 + 1] & mask) == mask) r2++;
+
+            uint16_t i;
+            for(i = r; i <= r2; i++) tiles[i] &= ~mask;
+
+            lv_area_t a;
+            lv_area_set(&a, c1 * LV_INV_TILE_SIZE, r * LV_INV_TILE_SIZE,
+                        LV_MATH_MIN((c2 + 1) * LV_INV_TILE_SIZE, hres) - 1,
+                        LV_MATH_MIN((r2 + 1) * LV_INV_TILE_SIZE, vres) - 1);
+            if(a.x1 <= a.x2 && a.y1 <= a.y2) lv_refr_save_area(disp_refr, &a);
+        }
+    }
+}
+#endif
+
+/**
+ * Save an area in the full invalidation buffer: of the saved areas and the new one, join the two
+ * whose join adds the least cost, then drop the areas the joined one now covers
+ * @param disp pointer to the display
+ * @param area_p the area to save
+ */
+static void lv_refr_make_room(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    lv_area_t * areas = disp->inv_areas;
+    uint16_t n = disp->inv_p;
+    uint32_t best_add = UINT32_MAX;
+    uint16_t best_i = 0;
+    uint16_t best_j = 0;
+    uint16_t i;
+    uint16_t j;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
 
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+    /*Index `n` stands for the new area*/
+    for(i = 0; i < n; i++) {
+        uint32_t cost_i = lv_refr_area_cost(disp, &areas[i]);
+        for(j = i + 1; j <= n; j++) {
+            const lv_area_t * b = j < n ? &areas[j] : area_p;
+            lv_area_join(&joined_area, &areas[i], b);
+            uint32_t cost_b = lv_refr_area_cost(disp, b);
+            uint32_t cost_j = lv_refr_area_cost(disp, &joined_area);
+            uint32_t add    = cost_j > cost_i + cost_b ? cost_j - cost_i - cost_b : 0;
+            if(add < best_add) {
+                best_add = add;
+                best_i   = i;
+                best_j   = j;
             }
+        }
+    }
 
-            lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
-
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+    lv_area_join(&areas[best_i], &areas[best_i], best_j < n ? &areas[best_j] : area_p);
+    if(best_j < n) lv_area_copy(&areas[best_j], area_p);
+
+    /*The joined area may cover others now*/
+    for(i = 0; i < disp->inv_p;) {
+        if(i != best_i && lv_area_is_in(&areas[i], &areas[best_i])) {
+            disp->inv_p--;
+            lv_area_copy(&areas[i], &areas[disp->inv_p]);
+            if(best_i == disp->inv_p) best_i = i;
+        } else {
+            i++;
+        }
+    }
+}
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+/**
+ * Join the invalidated areas while that lowers their total cost. Each step joins the pair which
+ * saves the most, so the result doesn't depend on the order of invalidation, and it stops once
+ * no pair saves anything.
+ */
+static void lv_refr_join_area(void)
+{
+    uint32_t cost[LV_INV_BUF_SIZE];
+    uint16_t n = disp_refr->inv_p;
+    uint16_t i;
+    uint16_t j;
+
+    if(n == 0) return;
+
+    for(i = 0; i < n; i++) cost[i] = lv_refr_area_cost(disp_refr, &disp_refr->inv_areas[i]);
+
+    disp_refr->inv_p_before_join = n;
+    disp_refr->inv_p_after_join  = n;
+
+    while(disp_refr->inv_p_after_join > 1) {
+        uint32_t best_save = 0;
+        uint32_t best_cost = 0;
+        uint16_t best_i    = 0;
+        uint16_t best_j    = 0;
+        lv_area_t best_area;
+        lv_area_t joined_area;
+
+        for(i = 0; i < n; i++) {
+            if(disp_refr->inv_area_joined[i] != 0) continue;
+            for(j = i + 1; j < n; j++) {
+                if(disp_refr->inv_area_joined[j] != 0) continue;
+
+                lv_area_join(&joined_area, &disp_refr->inv_areas[i], &disp_refr->inv_areas[j]);
+                uint32_t c = lv_refr_area_cost(disp_refr, &joined_area);
+                if(cost[i] + cost[j] > c + best_save) {
+                    best_save = cost[i] + cost[j] - c;
+                    best_cost = c;
+                    best_i    = i;
+                    best_j    = j;
+                    lv_area_copy(&best_area, &joined_area);
+                }
             }
         }
+
+        if(best_save == 0) break;
+
+        lv_area_copy(&disp_refr->inv_areas[best_i], &best_area);
+        cost[best_i] = best_cost;
+
+        /*Mark 'best_j' is joined into 'best_i'*/
+        disp_refr->inv_area_joined[best_j] = 1;
+        disp_refr->inv_p_after_join--;
     }
 }
 
@@ -271,11 +641,17 @@ static void lv_refr_areas(void)
     px_num = 0;
     uint32_t i;
 
+    if(disp_refr->inv_p != 0) {
+        disp_refr->px_drawn  = 0;
+        disp_refr->px_culled = 0;
+    }
+
     for(i = 0; i < disp_refr->inv_p; i++) {
         /*Refresh the unjoined areas*/
         if(disp_refr->inv_area_joined[i] == 0) {
 
             lv_refr_area(&disp_refr->inv_areas[i]);
+            LV_PROF_ADD(areas, 1);
 
             if(disp_refr->driver.monitor_cb) px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
         }
@@ -339,6 +715,12 @@ static void lv_refr_area(const lv_area_t * area_p)
             }
         }
 
+#if LV_USE_DRAW_LIST
+        /*Walk the objects only once if the area takes more than one strip*/
+        area_recorded = false;
+        if(y2 - area_p->y1 + 1 > max_row) area_recorded = lv_refr_area_record(area_p);
+#endif
+
         /*Always use the full row*/
         lv_coord_t row;
         lv_coord_t row_last = 0;
@@ -364,6 +746,10 @@ static void lv_refr_area(const lv_area_t * area_p)
             /*Refresh this part too*/
             lv_refr_area_part(area_p);
         }
+
+#if LV_USE_DRAW_LIST
+        area_recorded = false;
+#endif
     }
 }
 
@@ -375,38 +761,61 @@ static void lv_refr_area_part(const lv_area_t * area_p)
 {
 
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    LV_PROF_ADD(strips, 1);
 
     /*In non double buffered mode, before rendering the next part wait until the previous image is
      * flushed*/
     if(lv_disp_is_double_buf(disp_refr) == false) {
+        LV_PROF_START(prof_wait);
         while(vdb->flushing)
             ;
+        LV_PROF_ADD_TIME(wait_time, prof_wait);
     }
 
-    lv_obj_t * top_p;
-
     /*Get the new mask from the original area and the act. VDB
      It will be a part of 'area_p'*/
     lv_area_t start_mask;
     lv_area_intersect(&start_mask, area_p, &vdb->area);
 
-    /*Get the most top object which is not covered by others*/
-    top_p = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
-
-    /*Do the refreshing from the top object*/
-    lv_refr_obj_and_children(top_p, &start_mask);
-
-    /*Also refresh top and sys layer unconditionally*/
-    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
-    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
+#if LV_USE_DRAW_LIST
+    if(area_recorded) {
+        LV_PROF_START(prof_play);
+        lv_draw_list_play(&start_mask);
+        LV_PROF_ADD_TIME(play_time, prof_play);
+    } else
+#endif
+    {
+        lv_refr_scr_and_layers(&start_mask);
+    }
 
     /* In true double buffered mode flush only once when all areas were rendered.
      * In normal mode flush after every area */
     if(lv_disp_is_true_double_buf(disp_refr) == false) {
+#if LV_USE_STRIP_HASH
+        if(lv_refr_strip_unchanged()) return;
+#endif
+#if LV_USE_COL_DELTA
+        if(lv_refr_col_delta_flush()) return;
+#endif
         lv_refr_vdb_flush();
     }
 }
 
+#if LV_USE_DRAW_LIST
+/**
+ * Record what the objects draw on a whole area in the draw list, which then draws every strip of
+ * it without walking the objects again
+ * @param area_p pointer to the area to refresh
+ * @return true: the strips can be drawn from the list; false: something couldn't be recorded
+ */
+static bool lv_refr_area_record(const lv_area_t * area_p)
+{
+    lv_draw_list_start();
+    lv_refr_scr_and_layers(area_p);
+    return lv_draw_list_stop();
+}
+#endif
+
 /**
  * Search the most top object which fully covers an area
  * @param area_p pointer to an area
@@ -443,6 +852,35 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     return found_p;
 }
 
+/**
+ * Draw the active screen from the top object which covers the mask, then the top and sys layers
+ * @param mask_p pointer to an area, the objects will be drawn only here
+ */
+static void lv_refr_scr_and_layers(const lv_area_t * mask_p)
+{
+    /*Get the most top object which is not covered by others*/
+    lv_obj_t * top_p = lv_refr_get_top_obj(mask_p, lv_disp_get_scr_act(disp_refr));
+
+#if LV_USE_OCCLUSION
+    /*Walk the objects without drawing first to know which later objects cover the earlier ones*/
+    occluder_cnt  = 0;
+    draw_order    = 0;
+    occluder_walk = true;
+    lv_refr_obj_and_children(top_p, mask_p);
+    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), mask_p);
+    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), mask_p);
+    occluder_walk = false;
+    draw_order    = 0;
+#endif
+
+    /*Do the refreshing from the top object*/
+    lv_refr_obj_and_children(top_p, mask_p);
+
+    /*Also refresh top and sys layer unconditionally*/
+    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), mask_p);
+    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), mask_p);
+}
+
 /**
  * Make the refreshing from an object. Draw all its children and the youngers too.
  * @param top_p pointer to an objects. Start the drawing from it.
@@ -476,7 +914,12 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
         }
 
         /*Call the post draw design function of the parents of the to object*/
-        par->design_cb(par, mask_p, LV_DESIGN_DRAW_POST);
+#if LV_USE_OCCLUSION
+        if(occluder_walk == false)
+#endif
+        {
+            par->design_cb(par, mask_p, LV_DESIGN_DRAW_POST);
+        }
 
         /*The new border will be there last parents,
          *so the 'younger' brothers of parent will be refreshed*/
@@ -514,7 +957,31 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     if(union_ok != false) {
 
         /* Redraw the object */
+#if LV_USE_OCCLUSION
+        if(occluder_walk) {
+            lv_refr_add_occluder(obj, mask_ori_p);
+        } else {
+            /*Draw only the parts the objects drawn later don't cover*/
+            lv_area_t parts[LV_REFR_CULL_PARTS];
+            uint8_t part_cnt = lv_refr_cull(draw_order, &obj_ext_mask, parts);
+            uint32_t px      = 0;
+            uint8_t p;
+            LV_PROF_START(prof_design);
+            for(p = 0; p < part_cnt; p++) {
+                obj->design_cb(obj, &parts[p], LV_DESIGN_DRAW_MAIN);
+                px += lv_area_get_size(&parts[p]);
+            }
+            if(part_cnt > 0) LV_PROF_ADD_DESIGN(obj, prof_design);
+            disp_refr->px_drawn += px;
+            disp_refr->px_culled += lv_area_get_size(&obj_ext_mask) - px;
+        }
+        draw_order++;
+#else
+        LV_PROF_START(prof_design);
         obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+        LV_PROF_ADD_DESIGN(obj, prof_design);
+        disp_refr->px_drawn += lv_area_get_size(&obj_ext_mask);
+#endif
 
 #if MASK_AREA_DEBUG
         static lv_color_t debug_color = LV_COLOR_RED;
@@ -550,10 +1017,330 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
         }
 
         /* If all the children are redrawn make 'post draw' design */
-        obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+#if LV_USE_OCCLUSION
+        if(occluder_walk == false)
+#endif
+        {
+            LV_PROF_START(prof_post);
+            obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+            LV_PROF_ADD_DESIGN(obj, prof_post);
+        }
+    }
+}
+
+#if LV_USE_OCCLUSION
+/**
+ * Save the area an object surely covers with opaque pixels as an occluder of the objects drawn
+ * before it: its coordinates without the radius on every side, if its own cover check agrees
+ * @param obj pointer to an object being walked
+ * @param mask_p the area the object is visible in (the mask clipped by its parents)
+ */
+static void lv_refr_add_occluder(lv_obj_t * obj, const lv_area_t * mask_p)
+{
+    const lv_style_t * style = lv_obj_get_style(obj);
+    if(style->body.opa != LV_OPA_COVER || lv_obj_get_opa_scale(obj) != LV_OPA_COVER) return;
+
+    lv_coord_t r = style->body.radius;
+    if(r == LV_RADIUS_CIRCLE) return;
+
+    lv_area_t a;
+    lv_obj_get_coords(obj, &a);
+    a.x1 += r;
+    a.y1 += r;
+    a.x2 -= r;
+    a.y2 -= r;
+    if(lv_area_intersect(&a, &a, mask_p) == false) return;
+    if(obj->design_cb(obj, &a, LV_DESIGN_COVER_CHK) == false) return;
+
+    /*When all are in use replace the smallest if this one is larger*/
+    uint16_t i = occluder_cnt;
+    if(occluder_cnt < LV_OCCLUDER_MAX) {
+        occluder_cnt++;
+    } else {
+        uint16_t j;
+        i = 0;
+        for(j = 1; j < LV_OCCLUDER_MAX; j++) {
+            if(lv_area_get_size(&occluders[j].area) < lv_area_get_size(&occluders[i].area)) i = j;
+        }
+        if(lv_area_get_size(&occluders[i].area) >= lv_area_get_size(&a)) return;
+    }
+
+    lv_area_copy(&occluders[i].area, &a);
+    occluders[i].order = draw_order;
+}
+
+/**
+ * Find the parts of an area the objects drawn later don't cover. A part loses the edges they cover
+ * across its whole width or height, and while the largest one they cover inside a part is at
+ * least an eighth of it, the part is cut into the bands around that one.
+ * @param order the place in the drawing order of the object drawing on the area
+ * @param area_p pointer to the area
+ * @param parts store the parts here, at most `LV_REFR_CULL_PARTS`
+ * @return the number of parts, 0 if the area is fully covered
+ */
+static uint8_t lv_refr_cull(uint16_t order, const lv_area_t * area_p, lv_area_t * parts)
+{
+    lv_area_copy(&parts[0], area_p);
+    if(lv_refr_trim(order, &parts[0]) == false) return 0;
+
+    uint8_t cnt = 1;
+    uint8_t p   = 0;
+    /*Drawing an object in parts costs its design callback again for each*/
+    while(p < cnt && cnt + 3 <= LV_REFR_CULL_PARTS) {
+        lv_area_t a;
+        lv_area_t hole;
+        uint32_t hole_size = 0;
+        uint16_t i;
+        lv_area_copy(&a, &parts[p]);
+        for(i = 0; i < occluder_cnt; i++) {
+            lv_area_t tmp;
+            if(occluders[i].order <= order) continue;
+            if(lv_area_intersect(&tmp, &a, &occluders[i].area) == false) continue;
+            if(lv_area_get_size(&tmp) > hole_size) {
+                lv_area_copy(&hole, &tmp);
+                hole_size = lv_area_get_size(&tmp);
+            }
+        }
+
+        if(hole_size * 8 < lv_area_get_size(&a)) {
+            p++;
+            continue;
+        }
+
+        /*Replace the part with what the objects drawn later leave of the bands above, below,
+         *left and right of the hole*/
+        lv_area_t bands[4];
+        uint8_t b;
+        lv_area_set(&bands[0], a.x1, a.y1, a.x2, hole.y1 - 1);
+        lv_area_set(&bands[1], a.x1, hole.y2 + 1, a.x2, a.y2);
+        lv_area_set(&bands[2], a.x1, hole.y1, hole.x1 - 1, hole.y2);
+        lv_area_set(&bands[3], hole.x2 + 1, hole.y1, a.x2, hole.y2);
+
+        cnt--;
+        lv_area_copy(&parts[p], &parts[cnt]);
+        for(b = 0; b < 4; b++) {
+            if(bands[b].x1 > bands[b].x2 || bands[b].y1 > bands[b].y2) continue;
+            if(lv_refr_trim(order, &bands[b]) == false) continue;
+            lv_area_copy(&parts[cnt], &bands[b]);
+            cnt++;
+        }
     }
+
+    return cnt;
 }
 
+/**
+ * Remove from an area the edges which objects drawn later cover across the whole area, until
+ * none does
+ * @param order the place in the drawing order of the object drawing on the area
+ * @param area_p pointer to the area, made smaller
+ * @return false: the area is fully covered
+ */
+static bool lv_refr_trim(uint16_t order, lv_area_t * area_p)
+{
+    bool changed = true;
+    while(changed) {
+        changed = false;
+
+        uint16_t i;
+        for(i = 0; i < occluder_cnt; i++) {
+            const lv_area_t * o = &occluders[i].area;
+            if(occluders[i].order <= order) continue;
+
+            /*Across the whole width: cut from the top or the bottom*/
+            if(o->x1 <= area_p->x1 && o->x2 >= area_p->x2) {
+                if(o->y1 <= area_p->y1 && o->y2 >= area_p->y1) {
+                    area_p->y1 = o->y2 + 1;
+                    changed    = true;
+                }
+                if(o->y1 <= area_p->y2 && o->y2 >= area_p->y2) {
+                    area_p->y2 = o->y1 - 1;
+                    changed    = true;
+                }
+            }
+            /*Across the whole height: cut from the left or the right*/
+            else if(o->y1 <= area_p->y1 && o->y2 >= area_p->y2) {
+                if(o->x1 <= area_p->x1 && o->x2 >= area_p->x1) {
+                    area_p->x1 = o->x2 + 1;
+                    changed    = true;
+                }
+                if(o->x1 <= area_p->x2 && o->x2 >= area_p->x2) {
+                    area_p->x2 = o->x1 - 1;
+                    changed    = true;
+                }
+            }
+
+            if(area_p->x1 > area_p->x2 || area_p->y1 > area_p->y2) return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
+#if LV_USE_STRIP_HASH
+/**
+ * Tell whether the display shows the rendered strip already: the hash of its pixels is the same as
+ * when a strip was flushed to the same area the last time. The strip's hash is saved for the next
+ * time and the hashes of strips it overlaps are dropped, as it will be flushed over them.
+ * @return true: the strip doesn't need to be flushed
+ */
+static bool lv_refr_strip_unchanged(void)
+{
+    lv_disp_buf_t * vdb   = lv_disp_get_buf(disp_refr);
+    uint32_t size         = lv_area_get_size(&vdb->area);
+    const lv_color_t * px = vdb->buf_act;
+
+    /*FNV-1a over the pixels*/
+    uint32_t hash = 2166136261UL;
+    uint32_t i;
+    for(i = 0; i < size; i++) hash = (hash ^ px[i].full) * 16777619UL;
+
+    lv_disp_strip_hash_t * entry = NULL;
+    uint16_t e;
+    for(e = 0; e < LV_STRIP_HASH_CNT; e++) {
+        lv_disp_strip_hash_t * h = &disp_refr->strip_hash[e];
+        lv_area_t tmp;
+        if(h->area.x1 == vdb->area.x1 && h->area.y1 == vdb->area.y1 && h->area.x2 == vdb->area.x2 &&
+           h->area.y2 == vdb->area.y2) {
+            entry = h;
+        } else if(lv_area_intersect(&tmp, &h->area, &vdb->area)) {
+            lv_area_set(&h->area, 0, 0, -1, -1);
+        }
+    }
+
+    if(entry != NULL && entry->hash == hash) {
+        disp_refr->strips_skipped++;
+        disp_refr->bytes_skipped += size * sizeof(lv_color_t);
+        return true;
+    }
+
+    if(entry == NULL) {
+        entry = &disp_refr->strip_hash[disp_refr->strip_hash_next];
+        disp_refr->strip_hash_next++;
+        if(disp_refr->strip_hash_next >= LV_STRIP_HASH_CNT) disp_refr->strip_hash_next = 0;
+        lv_area_copy(&entry->area, &vdb->area);
+    }
+    entry->hash = hash;
+
+    return false;
+}
+#endif
+
+#if LV_USE_COL_DELTA
+/**
+ * Flush only the columns of the VDB whose pixels changed since they were flushed, as windows of
+ * whole column groups. The signatures of the strip's rows are saved for the next time.
+ * Every window but the last is copied to the other buffer and flushed from there; the last one is
+ * moved to the start of the VDB and flushed as usual. With one buffer only one window is flushed.
+ * @return true: the strip is flushed (or didn't need to be); false: flush the whole VDB
+ */
+static bool lv_refr_col_delta_flush(void)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    lv_area_t * a       = &vdb->area;
+
+    lv_coord_t w          = lv_area_get_width(a);
+    lv_coord_t h          = lv_area_get_height(a);
+    const lv_color_t * px = vdb->buf_act;
+
+    /*Mark the column groups which changed in any row*/
+    uint32_t changed = 0;
+    lv_coord_t y;
+    for(y = a->y1; y <= a->y2; y++) {
+        lv_coord_t x = a->x1;
+        while(x <= a->x2) {
+            uint16_t g       = x / LV_COL_DELTA_W;
+            lv_coord_t x_end = LV_MATH_MIN((g + 1) * LV_COL_DELTA_W - 1, a->x2);
+            uint32_t hash    = 2166136261UL ^ (uint32_t)x; /*FNV-1a; a part of a group hashes otherwise*/
+            for(; x <= x_end; x++) hash = (hash ^ px[x - a->x1].full) * 16777619UL;
+
+            uint32_t bit = (uint32_t)1 << g;
+            if((disp_refr->col_sig_known[y] & bit) == 0 || disp_refr->col_sig[y][g] != hash) changed |= bit;
+            disp_refr->col_sig[y][g] = hash;
+            disp_refr->col_sig_known[y] |= bit;
+        }
+        px += w;
+    }
+
+    uint32_t size = lv_area_get_size(a);
+    if(changed == 0) {
+        disp_refr->strips_skipped++;
+        disp_refr->bytes_skipped += size * sizeof(lv_color_t);
+        return true;
+    }
+
+    /*Make windows of the changed groups. Join two if the columns between cost less to send than
+     * a window. With one buffer only one window can be flushed.*/
+    lv_coord_t win_x1[(LV_COL_DELTA_COLS + 1) / 2];
+    lv_coord_t win_x2[(LV_COL_DELTA_COLS + 1) / 2];
+    uint16_t win_cnt = 0;
+    uint16_t g;
+    for(g = a->x1 / LV_COL_DELTA_W; g <= a->x2 / LV_COL_DELTA_W; g++) {
+        if((changed & ((uint32_t)1 << g)) == 0) continue;
+
+        lv_coord_t x1 = LV_MATH_MAX(g * LV_COL_DELTA_W, a->x1);
+        lv_coord_t x2 = LV_MATH_MIN((g + 1) * LV_COL_DELTA_W - 1, a->x2);
+        if(win_cnt > 0 && (win_x2[win_cnt - 1] + 1 == x1 || lv_disp_is_double_buf(disp_refr) == false ||
+                           (uint32_t)(x1 - win_x2[win_cnt - 1] - 1) * h <= LV_COL_DELTA_WIN_COST)) {
+            win_x2[win_cnt - 1] = x2;
+        } else {
+            win_x1[win_cnt] = x1;
+            win_x2[win_cnt] = x2;
+            win_cnt++;
+        }
+    }
+
+    if(win_cnt == 1 && win_x1[0] == a->x1 && win_x2[0] == a->x2) return false;
+
+    lv_disp_t * disp = lv_refr_get_disp_refreshing();
+    lv_color_t * buf_act = vdb->buf_act;
+    lv_color_t * buf_ina = vdb->buf_act == vdb->buf1 ? vdb->buf2 : vdb->buf1;
+    uint32_t px_sent     = 0;
+    uint16_t i;
+    for(i = 0; i < win_cnt; i++) {
+        lv_area_t win;
+        lv_area_set(&win, win_x1[i], a->y1, win_x2[i], a->y2);
+        if(disp->driver.rounder_cb) {
+            disp->driver.rounder_cb(&disp->driver, &win);
+            lv_area_intersect(&win, &win, a);
+        }
+
+        lv_coord_t win_w = lv_area_get_width(&win);
+        px_sent += lv_area_get_size(&win);
+        lv_color_t * src = buf_act + (win.x1 - a->x1);
+        lv_coord_t row;
+
+        if(i == win_cnt - 1) {
+            /*The window's rows go after each other to the start of the VDB*/
+            for(row = 0; row < h; row++) {
+                memmove(&buf_act[row * win_w], &src[row * w], win_w * sizeof(lv_color_t));
+            }
+            lv_area_copy(a, &win);
+            lv_refr_vdb_flush();
+        } else {
+            LV_PROF_START(prof_wait);
+            while(vdb->flushing)
+                ;
+            LV_PROF_ADD_TIME(wait_time, prof_wait);
+            for(row = 0; row < h; row++) {
+                memcpy(&buf_ina[row * win_w], &src[row * w], win_w * sizeof(lv_color_t));
+            }
+            vdb->flushing = 1;
+            LV_PROF_START(prof_flush);
+            if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &win, buf_ina);
+            LV_PROF_ADD_TIME(flush_time, prof_flush);
+            LV_PROF_ADD(flushes, 1);
+            LV_PROF_ADD(flush_bytes, lv_area_get_size(&win) * sizeof(lv_color_t));
+        }
+    }
+
+    disp_refr->bytes_skipped += (size - px_sent) * sizeof(lv_color_t);
+
+    return true;
+}
+#endif
+
 /**
  * Flush the content of the VDB
  */
@@ -564,15 +1351,21 @@ static void lv_refr_vdb_flush(void)
     /*In double buffered mode wait until the other buffer is flushed before flushing the current
      * one*/
     if(lv_disp_is_double_buf(disp_refr)) {
+        LV_PROF_START(prof_wait);
         while(vdb->flushing)
             ;
+        LV_PROF_ADD_TIME(wait_time, prof_wait);
     }
 
     vdb->flushing = 1;
 
     /*Flush the rendered content to the display*/
     lv_disp_t * disp = lv_refr_get_disp_refreshing();
+    LV_PROF_START(prof_flush);
     if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &vdb->area, vdb->buf_act);
+    LV_PROF_ADD_TIME(flush_time, prof_flush);
+    LV_PROF_ADD(flushes, 1);
+    LV_PROF_ADD(flush_bytes, lv_area_get_size(&vdb->area) * sizeof(lv_color_t));
 
     if(vdb->buf1 && vdb->buf2) {
         if(vdb->buf_act == vdb->buf1)
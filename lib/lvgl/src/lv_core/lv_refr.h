@@ -62,6 +62,22 @@ void lv_refr_now(lv_disp_t * disp);
  */
 void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+#if LV_USE_HW_SCROLL
+/**
+ * Let the display move a band of full-width rows itself instead of redrawing it.
+ * To be called from `LV_SIGNAL_CORD_CHG` of an object moved by `lv_obj_set_pos` (e.g. a page's
+ * scrollable), while the invalidation of its old area is still the last one saved.
+ * @param disp pointer to the display
+ * @param band the rows to move (`x1` and `x2` are ignored, the whole width moves)
+ * @param dy move the rows by this much (positive: down)
+ * @param old_area the area invalidated for the object's old position
+ * @return true: the rows were moved, the old area's invalidation was replaced by the rows the move
+ *         exposed and the caller must skip the invalidation of the new area;
+ *         false: nothing changed, redraw as usual
+ */
+bool lv_refr_hw_scroll(lv_disp_t * disp, const lv_area_t * band, lv_coord_t dy, const lv_area_t * old_area);
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
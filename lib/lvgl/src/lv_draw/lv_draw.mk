@@ -6,6 +6,7 @@ CSRCS += lv_draw_line.c
 CSRCS += lv_draw_img.c
 CSRCS += lv_draw_arc.c
 CSRCS += lv_draw_triangle.c
+CSRCS += lv_draw_list.c
 CSRCS += lv_img_decoder.c
 CSRCS += lv_img_cache.c
 
@@ -71,6 +71,12 @@ static inline lv_color_t color_mix_2_alpha(lv_color_t bg_color, lv_opa_t bg_opa,
  */
 void lv_draw_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask_p, lv_color_t color, lv_opa_t opa)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_none();
+        return;
+    }
+#endif
 
     if(opa < LV_OPA_MIN) return;
     if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
@@ -122,6 +128,13 @@ void lv_draw_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask_p, lv_color_t
  */
 void lv_draw_fill(const lv_area_t * cords_p, const lv_area_t * mask_p, lv_color_t color, lv_opa_t opa)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_none();
+        return;
+    }
+#endif
+
     if(opa < LV_OPA_MIN) return;
     if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
 
@@ -233,6 +246,13 @@ void lv_draw_fill(const lv_area_t * cords_p, const lv_area_t * mask_p, lv_color_
 void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv_font_t * font_p, uint32_t letter,
                     lv_color_t color, lv_opa_t opa)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_none();
+        return;
+    }
+#endif
+
     /*clang-format off*/
     const uint8_t bpp1_opa_table[2]  = {0, 255};          /*Opacity mapping with bpp = 1 (Just for compatibility)*/
     const uint8_t bpp2_opa_table[4]  = {0, 85, 170, 255}; /*Opacity mapping with bpp = 2*/
@@ -386,6 +406,12 @@ void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv
 void lv_draw_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const uint8_t * map_p, lv_opa_t opa,
                  bool chroma_key, bool alpha_byte, lv_color_t recolor, lv_opa_t recolor_opa)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_none();
+        return;
+    }
+#endif
 
     if(opa < LV_OPA_MIN) return;
     if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
@@ -47,6 +47,13 @@ static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mas
 void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void * src, const lv_style_t * style,
                  lv_opa_t opa_scale)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_img(coords, mask, src, style, opa_scale);
+        return;
+    }
+#endif
+
     if(src == NULL) {
         LV_LOG_WARN("Image draw: src is NULL");
         lv_draw_rect(coords, mask, &lv_style_plain, LV_OPA_COVER);
@@ -58,6 +58,13 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
                    const char * txt, lv_txt_flag_t flag, lv_point_t * offset, uint16_t sel_start, uint16_t sel_end,
                    lv_draw_label_hint_t * hint)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_label(coords, mask, style, opa_scale, txt, flag, offset, sel_start, sel_end);
+        return;
+    }
+#endif
+
     const lv_font_t * font = style->text.font;
     lv_coord_t w;
     if((flag & LV_TXT_FLAG_EXPAND) == 0) {
@@ -78,6 +78,12 @@ static bool line_next_x(line_draw_t * line);
 void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
                   const lv_style_t * style, lv_opa_t opa_scale)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_line(point1, point2, mask, style, opa_scale);
+        return;
+    }
+#endif
 
     if(style->line.width == 0) return;
     if(point1->x == point2->x && point1->y == point2->y) return;
@@ -0,0 +1,369 @@
+/**
+ * @file lv_draw_list.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_draw_list.h"
+
+#if LV_USE_DRAW_LIST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SEL_OFF 0xFFFF /*No selection in `lv_draw_label()`*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+enum {
+    LV_DRAW_LIST_RECT,
+    LV_DRAW_LIST_LABEL,
+    LV_DRAW_LIST_IMG,
+    LV_DRAW_LIST_LINE,
+    LV_DRAW_LIST_TRIANGLE,
+    LV_DRAW_LIST_ARC,
+};
+typedef uint8_t lv_draw_list_type_t;
+
+/** One drawing function call as it was made, except that the mask doesn't contain the VDB strip
+ * yet, and with a copy of the style because objects may give a style which lives on their stack*/
+typedef struct
+{
+    lv_area_t mask;
+    const lv_style_t * style;     /**< The copy in the list*/
+    const lv_style_t * style_src; /**< The style given, to find copies to share*/
+    lv_draw_list_type_t type;
+    lv_opa_t opa_scale;
+    union
+    {
+        struct
+        {
+            lv_area_t coords;
+            const void * src; /**< Image sources belong to their objects, they are not copied*/
+        } area; /**< Rectangles and images*/
+
+        /** One line of a label, as a label of its own: its copy of the text, and `coords` moved
+         * by the offset and down to the line*/
+        struct
+        {
+            lv_area_t coords;
+            const char * txt;
+            lv_txt_flag_t flag;
+            uint16_t sel_start;
+            uint16_t sel_end;
+        } label;
+
+        lv_point_t points[3]; /**< Lines and triangles*/
+
+        struct
+        {
+            lv_coord_t x;
+            lv_coord_t y;
+            uint16_t radius;
+            uint16_t start_angle;
+            uint16_t end_angle;
+        } arc;
+    } p;
+} lv_draw_list_op_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_draw_list_op_t * op_add(lv_draw_list_type_t type, const lv_area_t * mask, const lv_style_t * style,
+                                  lv_opa_t opa_scale);
+static void * data_add(uint32_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/*The operations grow from the start of the buffer, the styles and texts they refer to from its end*/
+static void * buf[LV_DRAW_LIST_SIZE / sizeof(void *)];
+static uint16_t op_cnt;
+static uint32_t data_start;
+static bool rec;
+static bool rec_ok;
+
+/**********************
+ *      MACROS
+ **********************/
+#define LIST_OPS ((lv_draw_list_op_t *)buf)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Start recording: until `lv_draw_list_stop()` the drawing functions add an operation to the list
+ * instead of drawing
+ */
+void lv_draw_list_start(void)
+{
+    op_cnt     = 0;
+    data_start = sizeof(buf);
+    rec        = true;
+    rec_ok     = true;
+}
+
+/**
+ * Stop recording
+ * @return true: the list holds everything drawn since `lv_draw_list_start()`;
+ *         false: something didn't fit or can't be recorded, the list must not be played
+ */
+bool lv_draw_list_stop(void)
+{
+    rec = false;
+    if(rec_ok == false) op_cnt = 0;
+
+    return rec_ok;
+}
+
+/**
+ * Tell whether the drawing functions are being recorded
+ * @return true: recording
+ */
+bool lv_draw_list_is_rec(void)
+{
+    return rec;
+}
+
+/**
+ * Draw the recorded operations which touch an area
+ * @param mask draw only here (typically the VDB strip being rendered)
+ */
+void lv_draw_list_play(const lv_area_t * mask)
+{
+    uint16_t i;
+    for(i = 0; i < op_cnt; i++) {
+        const lv_draw_list_op_t * op = &LIST_OPS[i];
+        lv_area_t m;
+
+        if(lv_area_intersect(&m, &op->mask, mask) == false) continue;
+
+        switch(op->type) {
+            case LV_DRAW_LIST_RECT: lv_draw_rect(&op->p.area.coords, &m, op->style, op->opa_scale); break;
+            case LV_DRAW_LIST_LABEL:
+                /*The same test `lv_draw_label()` skips lines with*/
+                if(op->p.label.coords.y2 + 1 < m.y1 || op->p.label.coords.y1 > m.y2) break;
+                lv_draw_label(&op->p.label.coords, &m, op->style, op->opa_scale, op->p.label.txt, op->p.label.flag,
+                              NULL, op->p.label.sel_start, op->p.label.sel_end, NULL);
+                break;
+            case LV_DRAW_LIST_IMG:
+                lv_draw_img(&op->p.area.coords, &m, op->p.area.src, op->style, op->opa_scale);
+                break;
+            case LV_DRAW_LIST_LINE:
+                lv_draw_line(&op->p.points[0], &op->p.points[1], &m, op->style, op->opa_scale);
+                break;
+            case LV_DRAW_LIST_TRIANGLE: lv_draw_triangle(op->p.points, &m, op->style, op->opa_scale); break;
+            case LV_DRAW_LIST_ARC:
+                lv_draw_arc(op->p.arc.x, op->p.arc.y, op->p.arc.radius, &m, op->p.arc.start_angle,
+                            op->p.arc.end_angle, op->style, op->opa_scale);
+                break;
+        }
+    }
+}
+
+/**
+ * Get the number of operations in the list
+ * @return the number of recorded operations
+ */
+uint16_t lv_draw_list_get_op_cnt(void)
+{
+    return op_cnt;
+}
+
+void lv_draw_list_add_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                           lv_opa_t opa_scale)
+{
+    if(lv_area_get_height(coords) < 1 || lv_area_get_width(coords) < 1) return;
+
+    lv_draw_list_op_t * op = op_add(LV_DRAW_LIST_RECT, mask, style, opa_scale);
+    if(op == NULL) return;
+
+    lv_area_copy(&op->p.area.coords, coords);
+}
+
+/*The lines are broken here once, the same way `lv_draw_label()` does, and each visible line is
+ * saved as a label of its own which strips not touching it skip without looking at its text*/
+void lv_draw_list_add_label(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                            lv_opa_t opa_scale, const char * txt, lv_txt_flag_t flag, const lv_point_t * offset,
+                            uint16_t sel_start, uint16_t sel_end)
+{
+    const lv_font_t * font = style->text.font;
+    lv_coord_t w;
+    if((flag & LV_TXT_FLAG_EXPAND) == 0) {
+        w = lv_area_get_width(coords);
+    } else {
+        lv_point_t p;
+        lv_txt_get_size(&p, txt, style->text.font, style->text.letter_space, style->text.line_space, LV_COORD_MAX,
+                        flag);
+        w = p.x;
+    }
+
+    lv_coord_t line_height = lv_font_get_line_height(font) + style->text.line_space;
+    lv_coord_t x_ofs       = offset != NULL ? offset->x : 0;
+    lv_coord_t y           = coords->y1 + (offset != NULL ? offset->y : 0);
+    uint32_t line_start    = 0;
+
+    while(txt[line_start] != '\0' && y <= mask->y2) {
+        uint32_t len = lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, w, flag);
+        if(len == 0) break;
+
+        if(y + line_height >= mask->y1) {
+            lv_draw_list_op_t * op = op_add(LV_DRAW_LIST_LABEL, mask, style, opa_scale);
+            char * line            = data_add(len + 1);
+            if(op == NULL || line == NULL) return;
+
+            memcpy(line, &txt[line_start], len);
+            line[len] = '\0';
+
+            op->p.label.txt       = line;
+            op->p.label.flag      = flag;
+            op->p.label.coords.x1 = coords->x1 + x_ofs;
+            op->p.label.coords.x2 = coords->x2 + x_ofs;
+            op->p.label.coords.y1 = y;
+            op->p.label.coords.y2 = y + line_height - 1;
+
+            /*Selection indices count the letters from the start of the whole text*/
+            op->p.label.sel_start = SEL_OFF;
+            op->p.label.sel_end   = SEL_OFF;
+            if(sel_start != SEL_OFF && sel_end != SEL_OFF) {
+                uint16_t char_id = lv_encoded_get_char_id(txt, line_start);
+                if(sel_end > char_id) {
+                    op->p.label.sel_start = sel_start > char_id ? sel_start - char_id : 0;
+                    op->p.label.sel_end   = sel_end - char_id;
+                }
+            }
+        }
+
+        line_start += len;
+        y += line_height;
+    }
+}
+
+void lv_draw_list_add_img(const lv_area_t * coords, const lv_area_t * mask, const void * src,
+                          const lv_style_t * style, lv_opa_t opa_scale)
+{
+    lv_draw_list_op_t * op = op_add(LV_DRAW_LIST_IMG, mask, style, opa_scale);
+    if(op == NULL) return;
+
+    lv_area_copy(&op->p.area.coords, coords);
+    op->p.area.src = src;
+}
+
+void lv_draw_list_add_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
+                           const lv_style_t * style, lv_opa_t opa_scale)
+{
+    if(style->line.width == 0) return;
+
+    lv_draw_list_op_t * op = op_add(LV_DRAW_LIST_LINE, mask, style, opa_scale);
+    if(op == NULL) return;
+
+    op->p.points[0] = *point1;
+    op->p.points[1] = *point2;
+}
+
+void lv_draw_list_add_triangle(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style,
+                               lv_opa_t opa_scale)
+{
+    lv_draw_list_op_t * op = op_add(LV_DRAW_LIST_TRIANGLE, mask, style, opa_scale);
+    if(op == NULL) return;
+
+    memcpy(op->p.points, points, sizeof(op->p.points));
+}
+
+void lv_draw_list_add_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, const lv_area_t * mask,
+                          uint16_t start_angle, uint16_t end_angle, const lv_style_t * style, lv_opa_t opa_scale)
+{
+    lv_draw_list_op_t * op = op_add(LV_DRAW_LIST_ARC, mask, style, opa_scale);
+    if(op == NULL) return;
+
+    op->p.arc.x           = center_x;
+    op->p.arc.y           = center_y;
+    op->p.arc.radius      = radius;
+    op->p.arc.start_angle = start_angle;
+    op->p.arc.end_angle   = end_angle;
+}
+
+/**
+ * Called by the drawing functions which have no operation in the list: the recording fails
+ */
+void lv_draw_list_add_none(void)
+{
+    rec_ok = false;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add an operation to the list with a copy of its style, shared with an earlier operation if it
+ * was given the same style with the same content
+ * @param type type of the operation
+ * @param mask the mask the drawing function got
+ * @param style the style the drawing function got
+ * @param opa_scale the opacity scale the drawing function got
+ * @return the new operation to fill in, or NULL if the list is full or failed already
+ */
+static lv_draw_list_op_t * op_add(lv_draw_list_type_t type, const lv_area_t * mask, const lv_style_t * style,
+                                  lv_opa_t opa_scale)
+{
+    if(rec_ok == false) return NULL;
+
+    const lv_style_t * copy = NULL;
+    uint16_t i;
+    for(i = op_cnt; i > 0; i--) {
+        const lv_draw_list_op_t * prev = &LIST_OPS[i - 1];
+        if(prev->style_src == style) {
+            if(memcmp(prev->style, style, sizeof(lv_style_t)) == 0) copy = prev->style;
+            break;
+        }
+    }
+
+    if(copy == NULL) {
+        lv_style_t * new_copy = data_add(sizeof(lv_style_t));
+        if(new_copy == NULL) return NULL;
+        memcpy(new_copy, style, sizeof(lv_style_t));
+        copy = new_copy;
+    }
+
+    if((op_cnt + 1) * sizeof(lv_draw_list_op_t) > data_start) {
+        rec_ok = false;
+        return NULL;
+    }
+
+    lv_draw_list_op_t * op = &LIST_OPS[op_cnt];
+    op_cnt++;
+    lv_area_copy(&op->mask, mask);
+    op->style     = copy;
+    op->style_src = style;
+    op->type      = type;
+    op->opa_scale = opa_scale;
+
+    return op;
+}
+
+/**
+ * Allocate data for the operations from the end of the list's buffer
+ * @param size the number of bytes needed
+ * @return pointer to the data, aligned for pointers, or NULL if it didn't fit
+ */
+static void * data_add(uint32_t size)
+{
+    if(rec_ok == false) return NULL;
+
+    size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    if(data_start < size || data_start - size < op_cnt * sizeof(lv_draw_list_op_t)) {
+        rec_ok = false;
+        return NULL;
+    }
+
+    data_start -= size;
+    return (uint8_t *)buf + data_start;
+}
+
+#endif /*LV_USE_DRAW_LIST*/
@@ -0,0 +1,93 @@
+/**
+ * @file lv_draw_list.h
+ * Record what the objects draw on an area once and replay it for every VDB strip
+ */
+
+#ifndef LV_DRAW_LIST_H
+#define LV_DRAW_LIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw.h"
+
+#if LV_USE_DRAW_LIST
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start recording: until `lv_draw_list_stop()` the drawing functions add an operation to the list
+ * instead of drawing
+ */
+void lv_draw_list_start(void);
+
+/**
+ * Stop recording
+ * @return true: the list holds everything drawn since `lv_draw_list_start()`;
+ *         false: something didn't fit or can't be recorded, the list must not be played
+ */
+bool lv_draw_list_stop(void);
+
+/**
+ * Tell whether the drawing functions are being recorded
+ * @return true: recording
+ */
+bool lv_draw_list_is_rec(void);
+
+/**
+ * Draw the recorded operations which touch an area
+ * @param mask draw only here (typically the VDB strip being rendered)
+ */
+void lv_draw_list_play(const lv_area_t * mask);
+
+/**
+ * Get the number of operations in the list
+ * @return the number of recorded operations
+ */
+uint16_t lv_draw_list_get_op_cnt(void);
+
+/*Called by the drawing functions while recording, with their own parameters*/
+void lv_draw_list_add_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                           lv_opa_t opa_scale);
+void lv_draw_list_add_label(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                            lv_opa_t opa_scale, const char * txt, lv_txt_flag_t flag, const lv_point_t * offset,
+                            uint16_t sel_start, uint16_t sel_end);
+void lv_draw_list_add_img(const lv_area_t * coords, const lv_area_t * mask, const void * src,
+                          const lv_style_t * style, lv_opa_t opa_scale);
+void lv_draw_list_add_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
+                           const lv_style_t * style, lv_opa_t opa_scale);
+void lv_draw_list_add_triangle(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style,
+                               lv_opa_t opa_scale);
+void lv_draw_list_add_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, const lv_area_t * mask,
+                          uint16_t start_angle, uint16_t end_angle, const lv_style_t * style, lv_opa_t opa_scale);
+
+/**
+ * Called by the drawing functions which have no operation in the list: the recording fails
+ */
+void lv_draw_list_add_none(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_LIST*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_LIST_H*/
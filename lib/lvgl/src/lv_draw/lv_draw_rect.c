@@ -78,6 +78,13 @@ static lv_opa_t antialias_get_opa_circ(lv_coord_t seg, lv_coord_t px_id, lv_opa_
  */
 void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_rect(coords, mask, style, opa_scale);
+        return;
+    }
+#endif
+
     if(lv_area_get_height(coords) < 1 || lv_area_get_width(coords) < 1) return;
 
 #if LV_USE_SHADOW
@@ -45,6 +45,12 @@ static void point_swap(lv_point_t * p1, lv_point_t * p2);
  */
 void lv_draw_triangle(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_triangle(points, mask, style, opa_scale);
+        return;
+    }
+#endif
 
     /*Return is the triangle is degenerated*/
     if(points[0].x == points[1].x && points[0].y == points[1].y) return;
@@ -89,6 +95,13 @@ void lv_draw_triangle(const lv_point_t * points, const lv_area_t * mask, const l
 void lv_draw_polygon(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask, const lv_style_t * style,
                      lv_opa_t opa_scale)
 {
+#if LV_USE_DRAW_LIST
+    if(lv_draw_list_is_rec()) {
+        lv_draw_list_add_none();
+        return;
+    }
+#endif
+
     if(point_cnt < 3) return;
     if(points == NULL) return;
 
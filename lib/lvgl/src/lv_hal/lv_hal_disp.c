@@ -76,11 +76,21 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->gpu_fill_cb  = NULL;
 #endif
 
+#if LV_USE_HW_SCROLL
+    driver->scroll_cb = NULL;
+#endif
+
+#if LV_USE_REFR_PACING
+    driver->wake_cb = NULL;
+#endif
+
 #if LV_USE_USER_DATA
     driver->user_data = NULL;
 #endif
 
     driver->set_px_cb = NULL;
+    driver->area_cost = 0;
+    driver->area_cost_cb = NULL;
 }
 
 /**
@@ -134,6 +144,32 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
                                         new display*/
 
     disp->inv_p = 0;
+    disp->inv_p_before_join = 0;
+    disp->inv_p_after_join  = 0;
+    disp->inv_overflows     = 0;
+    disp->px_drawn          = 0;
+    disp->px_culled         = 0;
+    disp->strips_skipped    = 0;
+    disp->bytes_skipped     = 0;
+#if LV_USE_STRIP_HASH
+    lv_disp_clean_strip_hash(disp);
+#endif
+#if LV_USE_COL_DELTA
+    lv_disp_clean_col_sig(disp);
+#endif
+#if LV_INV_TILES
+    memset(disp->inv_tiles, 0, sizeof(disp->inv_tiles));
+#endif
+#if LV_USE_REFR_PACING
+    disp->refr_task   = NULL; /*Invalidating the new screens below doesn't schedule anything*/
+    disp->refr_last   = lv_tick_get();
+    disp->refr_period = LV_REFR_MIN_PERIOD;
+#endif
+
+#if LV_USE_HW_SCROLL
+    lv_area_set(&disp->hw_scroll_band, 0, 0, -1, -1);
+    disp->hw_scroll_skip = NULL;
+#endif
 
     disp->act_scr   = lv_obj_create(NULL, NULL); /*Create a default screen on the display*/
     disp->top_layer = lv_obj_create(NULL, NULL); /*Create top layer on the display*/
@@ -171,6 +207,83 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
     }
 }
 
+/**
+ * Turn the display by 90 degrees in run time, after its driver has turned the panel's
+ * scanning the same way, so nothing is transposed while rendering. The screens and the
+ * layers are resized and the display is invalidated once as a whole.
+ * @param disp pointer to a display (NULL to use the default display)
+ * @param rotated true: swap the driver's `hor_res` and `ver_res`
+ */
+void lv_disp_set_rotated(lv_disp_t * disp, bool rotated)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) return;
+
+    disp->driver.rotated = rotated ? 1 : 0;
+
+    lv_area_t scr_area;
+    lv_area_set(&scr_area, 0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1);
+
+    lv_obj_t * scr;
+    LV_LL_READ(disp->scr_ll, scr)
+    {
+        lv_obj_set_size(scr, lv_area_get_width(&scr_area), lv_area_get_height(&scr_area));
+    }
+
+#if LV_USE_HW_SCROLL
+    /*The panel's scrolling does not survive the rotation*/
+    lv_area_set(&disp->hw_scroll_band, 0, 0, -1, -1);
+    disp->hw_scroll_skip = NULL;
+#endif
+
+#if LV_USE_STRIP_HASH
+    /*The panel shows the old content at other places now*/
+    lv_disp_clean_strip_hash(disp);
+#endif
+#if LV_USE_COL_DELTA
+    lv_disp_clean_col_sig(disp);
+#endif
+
+    /*Everything is redrawn anyway: drop the areas the resizing invalidated*/
+    lv_inv_area(disp, NULL);
+    lv_inv_area(disp, &scr_area);
+}
+
+#if LV_USE_STRIP_HASH
+/**
+ * Forget what the flushed strips showed, so unchanged strips are flushed again. Needed when the
+ * panel's content changes other than by flushing, e.g. when drawing to it directly.
+ * @param disp pointer to a display (NULL to use the default display)
+ */
+void lv_disp_clean_strip_hash(lv_disp_t * disp)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) return;
+
+    uint16_t i;
+    for(i = 0; i < LV_STRIP_HASH_CNT; i++) {
+        lv_area_set(&disp->strip_hash[i].area, 0, 0, -1, -1);
+        disp->strip_hash[i].hash = 0;
+    }
+    disp->strip_hash_next = 0;
+}
+#endif
+
+#if LV_USE_COL_DELTA
+/**
+ * Forget the signatures of the flushed columns, so unchanged columns are flushed again. Needed
+ * when the panel's content changes other than by flushing, e.g. when drawing to it directly.
+ * @param disp pointer to a display (NULL to use the default display)
+ */
+void lv_disp_clean_col_sig(lv_disp_t * disp)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) return;
+
+    memset(disp->col_sig_known, 0, sizeof(disp->col_sig_known));
+}
+#endif
+
 /**
  * Remove a display
  * @param disp pointer to display
@@ -30,6 +30,25 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas */
 #endif
 
+#if LV_INV_TILES
+/*Dirty tiles are kept for either orientation of the display*/
+#define LV_INV_TILE_SIDE_MAX (LV_HOR_RES_MAX > LV_VER_RES_MAX ? LV_HOR_RES_MAX : LV_VER_RES_MAX)
+#define LV_INV_TILE_COLS ((LV_INV_TILE_SIDE_MAX + LV_INV_TILE_SIZE - 1) / LV_INV_TILE_SIZE)
+#define LV_INV_TILE_ROWS LV_INV_TILE_COLS
+#if LV_INV_TILE_COLS > 32
+#error "LV_INV_TILE_SIZE is too small for the resolution: at most 32 tiles per row"
+#endif
+#endif
+
+#if LV_USE_COL_DELTA
+/*Flushed pixels are known by rows of column groups, for either orientation of the display*/
+#define LV_COL_DELTA_ROWS (LV_HOR_RES_MAX > LV_VER_RES_MAX ? LV_HOR_RES_MAX : LV_VER_RES_MAX)
+#define LV_COL_DELTA_COLS ((LV_COL_DELTA_ROWS + LV_COL_DELTA_W - 1) / LV_COL_DELTA_W)
+#if LV_COL_DELTA_COLS > 32
+#error "LV_COL_DELTA_W is too small for the resolution: at most 32 column groups"
+#endif
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -72,7 +91,8 @@ typedef struct _disp_drv_t
 #if LV_ANTIALIAS
     uint32_t antialiasing : 1; /**< 1: antialiasing is enabled on this display. */
 #endif
-    uint32_t rotated : 1; /**< 1: turn the display by 90 degree. @warning Does not update coordinates for you!*/
+    uint32_t rotated : 1; /**< 1: turn the display by 90 degree. @warning Does not update coordinates for you,
+                            use `lv_disp_set_rotated()` in run time*/
 
 #if LV_COLOR_SCREEN_TRANSP
     /**Handle if the the screen doesn't have a solid (opa == LV_OPA_COVER) background.
@@ -98,6 +118,14 @@ typedef struct _disp_drv_t
      * number of flushed pixels */
     void (*monitor_cb)(struct _disp_drv_t * disp_drv, uint32_t time, uint32_t px);
 
+    /** Fixed cost of every VDB strip an area is refreshed in (object tree walk, window setup,
+     * `flush_cb` call), in the time of as many pixels. Invalidated areas are joined whenever that
+     * lowers the sum of pixels plus strip costs. 0 by default*/
+    uint32_t area_cost;
+
+    /** OPTIONAL: Replace that model: return the cost of refreshing `area`, in any unit*/
+    uint32_t (*area_cost_cb)(struct _disp_drv_t * disp_drv, const lv_area_t * area);
+
 #if LV_USE_GPU
     /** OPTIONAL: Blend two memories using opacity (GPU only)*/
     void (*gpu_blend_cb)(struct _disp_drv_t * disp_drv, lv_color_t * dest, const lv_color_t * src, uint32_t length,
@@ -108,6 +136,19 @@ typedef struct _disp_drv_t
                         const lv_area_t * fill_area, lv_color_t color);
 #endif
 
+#if LV_USE_HW_SCROLL
+    /** OPTIONAL: Move the content of the full-width rows `area->y1..y2` by `dy` rows on the display
+     * itself (positive: down); what leaves one end may come back at the other. Return true if it did.
+     * Called with `area == NULL` to put a previously moved band back the way it was stored.*/
+    bool (*scroll_cb)(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dy);
+#endif
+
+#if LV_USE_REFR_PACING
+    /** OPTIONAL: Called when an invalidation schedules a refresh of the idle display, to wake up
+     * whatever sleeps until `lv_task_handler()` is due*/
+    void (*wake_cb)(struct _disp_drv_t * disp_drv);
+#endif
+
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_TRANSP` by default. (lv_conf.h)*/
     lv_color_t color_chroma_key;
@@ -120,6 +161,15 @@ typedef struct _disp_drv_t
 
 struct _lv_obj_t;
 
+#if LV_USE_STRIP_HASH
+/** What a flushed strip showed, see `LV_USE_STRIP_HASH`*/
+typedef struct
+{
+    lv_area_t area; /**< Where the strip was flushed (empty if the entry is unused)*/
+    uint32_t hash;  /**< Hash of its pixels*/
+} lv_disp_strip_hash_t;
+#endif
+
 /**
  * Display structure.
  * ::lv_disp_drv_t is the first member of the structure.
@@ -142,6 +192,34 @@ typedef struct _disp_t
     lv_area_t inv_areas[LV_INV_BUF_SIZE];
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint32_t inv_p : 10;
+#if LV_INV_TILES
+    uint32_t inv_tiles[LV_INV_TILE_ROWS]; /**< Dirty tiles: bit `x` of word `y` for tile (x, y)*/
+#endif
+    uint16_t inv_p_before_join; /**< Areas invalidated for the last refresh*/
+    uint16_t inv_p_after_join;  /**< Areas the last refresh drew, once joined*/
+    uint32_t inv_overflows;     /**< Areas saved into a full buffer by joining two, ever*/
+    uint32_t px_drawn;          /**< Pixels given to the objects' main drawing in the last refresh*/
+    uint32_t px_culled;         /**< Pixels not given to it because later objects cover them*/
+
+#if LV_USE_STRIP_HASH
+    lv_disp_strip_hash_t strip_hash[LV_STRIP_HASH_CNT];
+    uint16_t strip_hash_next; /**< Entry to reuse next*/
+#endif
+#if LV_USE_COL_DELTA
+    uint32_t col_sig[LV_COL_DELTA_ROWS][LV_COL_DELTA_COLS]; /**< Hashes of the flushed column groups*/
+    uint32_t col_sig_known[LV_COL_DELTA_ROWS];              /**< Bit `g`: `col_sig[y][g]` is valid*/
+#endif
+#if LV_USE_REFR_PACING
+    uint32_t refr_last;   /**< Start of the last refresh*/
+    uint16_t refr_period; /**< [ms] Least time between two refreshes, doubled by overrunning it*/
+#endif
+    uint32_t strips_skipped; /**< Strips not flushed because the display shows them already, ever*/
+    uint32_t bytes_skipped;  /**< Bytes of these strips and of unchanged columns in the VDB, ever*/
+
+#if LV_USE_HW_SCROLL
+    lv_area_t hw_scroll_band;          /**< Rows last moved by `scroll_cb` (empty if none)*/
+    struct _lv_obj_t * hw_scroll_skip; /**< Object whose next new-area invalidation is not needed*/
+#endif
 
     /*Miscellaneous data*/
     uint32_t last_activity_time; /**< Last time there was activity on this display */
@@ -191,6 +269,33 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver);
  */
 void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv);
 
+/**
+ * Turn the display by 90 degrees in run time, after its driver has turned the panel's
+ * scanning the same way, so nothing is transposed while rendering. The screens and the
+ * layers are resized and the display is invalidated once as a whole.
+ * @param disp pointer to a display (NULL to use the default display)
+ * @param rotated true: swap the driver's `hor_res` and `ver_res`
+ */
+void lv_disp_set_rotated(lv_disp_t * disp, bool rotated);
+
+#if LV_USE_STRIP_HASH
+/**
+ * Forget what the flushed strips showed, so unchanged strips are flushed again. Needed when the
+ * panel's content changes other than by flushing, e.g. when drawing to it directly.
+ * @param disp pointer to a display (NULL to use the default display)
+ */
+void lv_disp_clean_strip_hash(lv_disp_t * disp);
+#endif
+
+#if LV_USE_COL_DELTA
+/**
+ * Forget the signatures of the flushed columns, so unchanged columns are flushed again. Needed
+ * when the panel's content changes other than by flushing, e.g. when drawing to it directly.
+ * @param disp pointer to a display (NULL to use the default display)
+ */
+void lv_disp_clean_col_sig(lv_disp_t * disp);
+#endif
+
 /**
  * Remove a display
  * @param disp pointer to display
@@ -41,6 +41,7 @@ static bool anim_ready_handler(lv_anim_t * a);
  **********************/
 static uint32_t last_task_run;
 static bool anim_list_changed;
+static lv_task_t * anim_task_p;
 
 /**********************
  *      MACROS
@@ -57,7 +58,7 @@ void lv_anim_core_init(void)
 {
     lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
     last_task_run = lv_tick_get();
-    lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, NULL);
+    anim_task_p   = lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, NULL);
 }
 
 /**
@@ -103,6 +104,15 @@ void lv_anim_create(lv_anim_t * a)
      * It's important if it happens in a ready callback. (see `anim_task`)*/
     anim_list_changed = true;
 
+#if LV_USE_REFR_PACING
+    /*Wake the task up if it was sleeping without animations*/
+    if(anim_task_p->period == LV_TASK_PERIOD_NEVER) {
+        last_task_run = lv_tick_get();
+        lv_task_set_period(anim_task_p, LV_DISP_DEF_REFR_PERIOD);
+        lv_task_reset(anim_task_p);
+    }
+#endif
+
     LV_LOG_TRACE("animation created")
 }
 
@@ -423,6 +433,11 @@ static void anim_task(lv_task_t * param)
     }
 
     last_task_run = lv_tick_get();
+
+#if LV_USE_REFR_PACING
+    /*Nothing to animate: sleep until an animation is created*/
+    if(lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL) lv_task_set_period(anim_task_p, LV_TASK_PERIOD_NEVER);
+#endif
 }
 
 /**
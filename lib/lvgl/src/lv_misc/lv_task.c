@@ -340,6 +340,29 @@ uint8_t lv_task_get_idle(void)
     return idle_last;
 }
 
+/**
+ * Get the time until a task needs to run, e.g. to sleep that long before calling
+ * `lv_task_handler()` again
+ * @return the time in milliseconds (0: a task is ready, `LV_TASK_PERIOD_NEVER`: none will be)
+ */
+uint32_t lv_task_get_time_till_next(void)
+{
+    uint32_t till_next = LV_TASK_PERIOD_NEVER;
+    if(lv_task_run == false) return till_next;
+
+    lv_task_t * task;
+    LV_LL_READ(LV_GC_ROOT(_lv_task_ll), task)
+    {
+        if(task->prio == LV_TASK_PRIO_OFF) continue;
+
+        uint32_t elp = lv_tick_elaps(task->last_run);
+        if(elp >= task->period) return 0;
+        if(task->period - elp < till_next) till_next = task->period - elp;
+    }
+
+    return till_next;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -31,6 +31,10 @@ extern "C" {
 #ifndef LV_ATTRIBUTE_TASK_HANDLER
 #define LV_ATTRIBUTE_TASK_HANDLER
 #endif
+
+/*A task with this period runs only when it's made ready (or after about 24 days)*/
+#define LV_TASK_PERIOD_NEVER 0x7FFFFFFF
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -166,6 +170,13 @@ void lv_task_enable(bool en);
  */
 uint8_t lv_task_get_idle(void);
 
+/**
+ * Get the time until a task needs to run, e.g. to sleep that long before calling
+ * `lv_task_handler()` again
+ * @return the time in milliseconds (0: a task is ready, `LV_TASK_PERIOD_NEVER`: none will be)
+ */
+uint32_t lv_task_get_time_till_next(void);
+
 /**********************
  *      MACROS
  **********************/
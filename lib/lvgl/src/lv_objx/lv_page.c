@@ -10,6 +10,7 @@
 #if LV_USE_PAGE != 0
 
 #include "../lv_core/lv_group.h"
+#include "../lv_core/lv_disp.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_core/lv_refr.h"
@@ -46,6 +47,10 @@ static bool lv_scrl_design(lv_obj_t * scrl, const lv_area_t * mask, lv_design_mo
 static lv_res_t lv_page_signal(lv_obj_t * page, lv_signal_t sign, void * param);
 static lv_res_t lv_page_scrollable_signal(lv_obj_t * scrl, lv_signal_t sign, void * param);
 static void scrl_def_event_cb(lv_obj_t * scrl, lv_event_t event);
+#if LV_USE_HW_SCROLL
+static void page_hw_scroll(lv_obj_t * page, const lv_area_t * ori_coords, lv_coord_t dy);
+static bool page_band_uncovered(lv_obj_t * page, const lv_area_t * band);
+#endif
 #if LV_USE_ANIMATION
 static void edge_flash_anim(void * page, lv_anim_value_t v);
 static void edge_flash_anim_end(lv_anim_t * a);
@@ -56,6 +61,9 @@ static void edge_flash_anim_end(lv_anim_t * a);
  **********************/
 static lv_design_cb_t ancestor_design;
 static lv_signal_cb_t ancestor_signal;
+#if LV_USE_HW_SCROLL
+static uint8_t hw_scroll_lock; /*The scrollable is being re-positioned from its own signal*/
+#endif
 
 /**********************
  *      MACROS
@@ -1025,13 +1033,25 @@ static lv_res_t lv_page_scrollable_signal(lv_obj_t * scrl, lv_signal_t sign, voi
         }
 
         if(refr_x || refr_y) {
+#if LV_USE_HW_SCROLL
+            hw_scroll_lock++;
+#endif
             lv_obj_set_pos(scrl, new_x, new_y);
+#if LV_USE_HW_SCROLL
+            hw_scroll_lock--;
+#endif
 
             if(page_ext->scroll_prop_ip) {
                 if(refr_y) lv_obj_set_y(page_parent, lv_obj_get_y(page_parent) + diff_y);
                 if(refr_x) lv_obj_set_x(page_parent, lv_obj_get_x(page_parent) + diff_x);
             }
         }
+#if LV_USE_HW_SCROLL
+        /*A plain vertical scroll: maybe the display can move the content itself*/
+        else if(diff_x == 0 && diff_y != 0 && page_ext->scroll_prop_ip == 0 && hw_scroll_lock == 0) {
+            page_hw_scroll(page, ori_coords, diff_y);
+        }
+#endif
 
         lv_page_sb_refresh(page);
     } else if(sign == LV_SIGNAL_DRAG_END) {
@@ -1067,6 +1087,127 @@ static lv_res_t lv_page_scrollable_signal(lv_obj_t * scrl, lv_signal_t sign, voi
     return res;
 }
 
+#if LV_USE_HW_SCROLL
+/**
+ * Ask the display to move the content of a page in hardware after its scrollable moved vertically.
+ * Only for pages spanning the whole display width, with nothing drawn over them and a background
+ * that looks the same when moved vertically.
+ * @param page pointer to a page object
+ * @param ori_coords coordinates of the scrollable before the move
+ * @param dy vertical movement of the scrollable
+ */
+static void page_hw_scroll(lv_obj_t * page, const lv_area_t * ori_coords, lv_coord_t dy)
+{
+    lv_page_ext_t * ext      = lv_obj_get_ext_attr(page);
+    const lv_style_t * style = lv_obj_get_style(page);
+    lv_disp_t * disp         = lv_obj_get_disp(page);
+    lv_obj_t * scrl          = ext->scrl;
+
+    if(disp->driver.scroll_cb == NULL) return;
+    if(lv_obj_get_screen(page) != lv_disp_get_scr_act(disp)) return;
+    if(page->coords.x1 > 0 || page->coords.x2 < lv_disp_get_hor_res(disp) - 1) return;
+    if(style->body.opa != LV_OPA_COVER || style->body.main_color.full != style->body.grad_color.full) return;
+#if LV_USE_ANIMATION
+    if(ext->edge_flash.top_ip || ext->edge_flash.bottom_ip || ext->edge_flash.left_ip || ext->edge_flash.right_ip)
+        return;
+#endif
+
+    /*The rows with the rounded corners (and their anti-aliasing) or the top/bottom border stay
+     * where they are*/
+    lv_coord_t inset = style->body.radius;
+#if LV_ANTIALIAS
+    if(inset > 0 && lv_disp_get_antialiasing(disp)) inset++;
+#endif
+    if(style->body.border.width > 0 && style->body.border.opa > LV_OPA_TRANSP &&
+       (style->body.border.part & (LV_BORDER_TOP | LV_BORDER_BOTTOM))) {
+        inset = LV_MATH_MAX(inset, style->body.border.width);
+    }
+
+    lv_area_t band;
+    lv_area_copy(&band, &page->coords);
+    band.y1 += inset;
+    band.y2 -= inset;
+    if(band.y1 > band.y2) return;
+    if(page_band_uncovered(page, &band) == false) return;
+
+    /*The area `lv_obj_set_pos` invalidated for the old position (as `lv_obj_invalidate` does it)*/
+    lv_area_t old;
+    lv_area_copy(&old, ori_coords);
+    old.x1 -= scrl->ext_draw_pad;
+    old.y1 -= scrl->ext_draw_pad;
+    old.x2 += scrl->ext_draw_pad;
+    old.y2 += scrl->ext_draw_pad;
+    lv_obj_t * par = page;
+    while(par != NULL) {
+        if(lv_area_intersect(&old, &old, &par->coords) == false) return;
+        par = lv_obj_get_parent(par);
+    }
+
+    if(lv_refr_hw_scroll(disp, &band, dy, &old) == false) return;
+    disp->hw_scroll_skip = scrl;
+
+    /*The scrollbars are drawn over the content so they were moved too.
+     * `lv_page_sb_refresh` redraws their old and new place, but not where the move took them.*/
+    lv_area_t sb;
+    if(ext->sb.ver_draw) {
+        lv_area_set(&sb, page->coords.x1 + ext->sb.ver_area.x1, band.y1, page->coords.x1 + ext->sb.ver_area.x2,
+                    band.y2);
+        lv_inv_area(disp, &sb);
+    }
+    if(ext->sb.hor_draw) {
+        lv_area_copy(&sb, &ext->sb.hor_area);
+        lv_area_set_pos(&sb, page->coords.x1 + sb.x1, page->coords.y1 + sb.y1 + dy);
+        lv_inv_area(disp, &sb);
+    }
+}
+
+/**
+ * Check that nothing is drawn over a band of a page: no younger sibling of the page or of its
+ * parents and nothing on the top and system layers
+ * @param page pointer to a page object
+ * @param band area to check
+ * @return true: the band shows only the page and its children
+ */
+static bool page_band_uncovered(lv_obj_t * page, const lv_area_t * band)
+{
+    lv_disp_t * disp = lv_obj_get_disp(page);
+    lv_obj_t * obj   = page;
+    lv_obj_t * par   = lv_obj_get_parent(page);
+    lv_obj_t * i;
+    lv_area_t tmp;
+
+    while(par != NULL) {
+        /*Children are listed from the top-most one*/
+        LV_LL_READ(par->child_ll, i)
+        {
+            if(i == obj) break;
+            if(lv_obj_get_hidden(i)) continue;
+            lv_area_copy(&tmp, &i->coords);
+            tmp.y1 -= i->ext_draw_pad;
+            tmp.y2 += i->ext_draw_pad;
+            if(lv_area_intersect(&tmp, &tmp, band)) return false;
+        }
+        obj = par;
+        par = lv_obj_get_parent(par);
+    }
+
+    lv_obj_t * layers[2] = {lv_disp_get_layer_top(disp), lv_disp_get_layer_sys(disp)};
+    uint8_t l;
+    for(l = 0; l < 2; l++) {
+        LV_LL_READ(layers[l]->child_ll, i)
+        {
+            if(lv_obj_get_hidden(i)) continue;
+            lv_area_copy(&tmp, &i->coords);
+            tmp.y1 -= i->ext_draw_pad;
+            tmp.y2 += i->ext_draw_pad;
+            if(lv_area_intersect(&tmp, &tmp, band)) return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
 /**
  * Propagate the input device related event of the scrollable to the parent page background
  * It is used by default if the scrollable's event is not specified
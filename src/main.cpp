@@ -110,15 +110,110 @@ Serial pc(USBTX, USBRX, "NRF", 9600); // tx, rx
 
 
 
+/* disp_flush hands LVGL's VDB to the panel byte for byte, which is only
+ * right if LVGL already stores RGB565 in the panel's big-endian order */
+#if LV_COLOR_DEPTH != 16 || LV_COLOR_16_SWAP != 1
+#error "disp_flush needs LV_COLOR_DEPTH 16 and LV_COLOR_16_SWAP 1 in lv_conf.h"
+#endif
+
+static lv_disp_drv_t *flushing_drv;
+static Timer          boot_timer;       /* started first thing in main() */
+static int            first_pixel_ms = -1;
+static bool           flush_12bit;      /* see setDisplayDepth() */
+static bool           flush_dither;
+
+/* Static screens: once nothing has been flushed for DISP_LOW_POWER_MS and
+ * no animation runs, the panel keeps refreshing the whole screen as a
+ * partial area at 1/8 of its frame rate. The next flush or scroll puts it
+ * back into normal mode first. */
+#define DISP_LOW_POWER_MS   3000
+
+static bool     panel_low_power;
+static uint32_t panel_flush_tick;   /* lv_tick_get() of the last flush or scroll */
+
+/* Keeps its own time stamp: LVGL's inactivity time belongs to the input
+ * devices and screen savers, which drawing must not reset */
+static void panelWake(void)
+{
+    if (panel_low_power) {
+        tft.setPartialArea(0, 0);
+        panel_low_power = false;
+    }
+    panel_flush_tick = lv_tick_get();
+}
+
+static void panelPowerCheck(void)
+{
+    if (panel_low_power || lv_anim_count_running() || lv_task_get_idle() < 90) return;
+    if (lv_tick_elaps(panel_flush_tick) < DISP_LOW_POWER_MS) return;
+    panel_low_power = tft.setPartialArea(0, tft.height());
+}
+
+/* Runs from the SPI interrupt once the strip has left the buffer */
+static void disp_flush_done(void)
+{
+    lv_disp_flush_ready(flushing_drv);
+}
+
 static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
-    uint32_t size = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1) ;
+    uint32_t size = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1) * sizeof(lv_color_t);
     // pc.printf("xs:%d ys:%d xe:%d ye:%d\r\n", area->x1, area->y1, area->x2, area->y2);
+    panelWake();
     tft.setAddrWindow(area->x1, area->y1, area->x2, area->y2);
-    tft.pushColors(( uint16_t *)color_p, size);
-    lv_disp_flush_ready(disp_drv);
+
+    /* Return straight away so LVGL renders the next strip into the other
+     * buffer while this one is on the bus */
+    flushing_drv = disp_drv;
+    if (first_pixel_ms < 0) first_pixel_ms = boot_timer.read_ms();
+    if (flush_12bit) {
+        tft.pushBytes444Async((uint8_t *)color_p, size / sizeof(lv_color_t), flush_dither,
+                              callback(disp_flush_done));
+    } else {
+        tft.pushBytesAsync((const uint8_t *)color_p, size, callback(disp_flush_done));
+    }
 }
 
+/* Send the strips as RGB444, 3 bytes for 2 pixels instead of 4, optionally
+ * dithered; the panel is switched per strip, so a screen showing a photo
+ * can go back to 16 bits from its next flush on */
+void setDisplayDepth(bool twelveBit, bool dither)
+{
+    flush_12bit  = twelveBit;
+    flush_dither = dither;
+#if LV_USE_STRIP_HASH
+    lv_disp_clean_strip_hash(NULL);     /* same strips, other pixels on the panel */
+#endif
+#if LV_USE_COL_DELTA
+    lv_disp_clean_col_sig(NULL);
+#endif
+}
+
+#if LV_USE_HW_SCROLL
+/* Scroll full-width pages with the panel's vertical scrolling; LVGL then
+ * only renders the rows that came into view */
+static bool disp_scroll(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_coord_t dy)
+{
+    panelWake();
+    if (area == NULL) return tft.setScrollArea(0, 0);
+    if (!tft.setScrollArea(area->y1, area->y2 - area->y1 + 1)) return false;
+    tft.scroll(dy);
+    return true;
+}
+#endif
+
+#if LV_USE_REFR_PACING
+/* A refresh got scheduled: end the main loop's sleep, so it is not held
+ * back until the loop's next check */
+static void disp_wake(lv_disp_drv_t * /*disp_drv*/)
+{
+    eventQueue.break_dispatch();
+}
+#endif
+
+/* Both orientations render into the same buffers, so they hold 10 rows of
+ * the longer side */
+#define DISP_BUF_SIZE   (LV_MATH_MAX(LV_HOR_RES_MAX, LV_VER_RES_MAX) * 10)
 
 void setupLvgl()
 {
@@ -128,24 +223,76 @@ void setupLvgl()
     lv_disp_drv_init(&disp_drv);
 
     static lv_disp_buf_t disp_buf;
-    static lv_color_t buf1[LV_HOR_RES_MAX * 10];                        /*A buffer for 10 rows*/
-    static lv_color_t buf2[LV_HOR_RES_MAX * 10];                        /*An other buffer for 10 rows*/
-    lv_disp_buf_init(&disp_buf, buf1, buf2, LV_HOR_RES_MAX * 10);   /*Initialize the display buffer*/
+    static lv_color_t buf1[DISP_BUF_SIZE];                        /*A buffer for 10 rows*/
+    static lv_color_t buf2[DISP_BUF_SIZE];                        /*An other buffer for 10 rows*/
+    lv_disp_buf_init(&disp_buf, buf1, buf2, DISP_BUF_SIZE);   /*Initialize the display buffer*/
 
-    disp_drv.hor_res = 135;
-    disp_drv.ver_res = 240;
+    /*The panel in rotation 0; other rotations swap these in setDisplayRotation()*/
+    disp_drv.hor_res = tft.width();
+    disp_drv.ver_res = tft.height();
     disp_drv.flush_cb = disp_flush;
+    /*Window setup, starting the transfer and LVGL's walk of the objects take about
+      100us per strip, as long as 50 pixels need on the 8MHz bus*/
+    disp_drv.area_cost = 50;
+#if LV_USE_HW_SCROLL
+    disp_drv.scroll_cb = disp_scroll;
+#endif
+#if LV_USE_REFR_PACING
+    disp_drv.wake_cb = disp_wake;
+#endif
     /*Set a display buffer*/
     disp_drv.buffer = &disp_buf;
     lv_disp_drv_register(&disp_drv);
 }
 
+/* Turn the UI with the panel's MADCTL scan direction: LVGL keeps rendering
+ * rows in the logical orientation and the controller places them, so no
+ * pixel is ever transposed in software. 0..3 as Adafruit_ST7735::setRotation */
+void setDisplayRotation(uint8_t r)
+{
+    tft.setRotation(r);         // waits for a flush still on the bus
+    lv_disp_set_rotated(NULL, r & 1);
+}
+
 lv_obj_t *text ;
 
-void lv_tick_handler()
+/* The panel's start-up runs from the event queue: while it waits out its
+ * reset and sleep-out delays, main() goes on with LVGL, the UI and BLE */
+static void panelInitStep(void)
+{
+    uint32_t ms = tft.initStep();
+
+    if (ms) {
+        eventQueue.call_in(ms, panelInitStep);
+    } else {
+        tft.setLowFrameRate(8);     /* for panelPowerCheck() */
+        eventQueue.break_dispatch();    /* the first frame can go out now */
+    }
+}
+
+#if LV_USE_PROF
+/* Print LVGL's refresh profiles now and then; at 9600 baud a dump takes a
+ * few seconds, so it's not for builds that are being timed otherwise */
+#define PROF_DUMP_MS    10000
+
+static void profPrint(const char *line)
+{
+    pc.printf("%s\r\n", line);
+}
+
+static void profDump(void)
 {
-    lv_tick_inc(5);
+    lv_prof_dump(profPrint);
+    lv_prof_clear();
 }
+#endif
+
+/* The main loop sleeps in the event queue until LVGL's next task is due,
+ * but at least this often checks whether the panel can go to low power.
+ * Events changing the UI invalidate, and disp_wake() ends the sleep, so
+ * their refresh is not held back. LVGL reads its tick from the us ticker
+ * (LV_TICK_CUSTOM), so no timer interrupt wakes the CPU meanwhile. */
+#define LOOP_MAX_SLEEP_MS   100
 
 void runtask()
 {
@@ -154,31 +301,50 @@ void runtask()
 
 int main()
 {
+    boot_timer.start();
+    tft.beginST7789();
+    panelInitStep();        /* reset low now; the later steps come from the queue */
+
     // eventQueue.call_every(500, periodicCallback);
 
     // BLE &ble = BLE::Instance();
     // ble.onEventsToProcess(scheduleBleEventsProcessing);
     // ble.init(bleInitComplete);
 
-    // eventQueue.dispatch_forever();
-
-    tft.initST7789();
-
     setupLvgl();
+    // setDisplayDepth(true, true);    /* opt in to 12-bit dithered strips */
 
     text = lv_label_create(lv_scr_act(), NULL);
     lv_label_set_text(text, "T-Watch");
     lv_obj_align(text, NULL, LV_ALIGN_CENTER, 0, 0);
 
-    Ticker tick;
-    tick.attach_us(callback(lv_tick_handler), 5000);
+#if LV_USE_PROF
+    eventQueue.call_every(PROF_DUMP_MS, profDump);
+#endif
 
     Ticker tick1;
     tick1.attach_us(callback(runtask), 5000000);
 
+    bool reported = false;
     while (1) {
-        lv_task_handler();
-        wait_ms(5);
+        int sleep_ms = LOOP_MAX_SLEEP_MS;
+
+        /* Nothing is rendered before the panel is up, so the first frame
+         * goes out whole rather than into a panel still in reset */
+        if (tft.initDone()) {
+            lv_task_handler();
+            panelPowerCheck();
+#if LV_USE_REFR_PACING
+            sleep_ms = LV_MATH_MIN(lv_task_get_time_till_next(), (uint32_t)LOOP_MAX_SLEEP_MS);
+#else
+            sleep_ms = 5;
+#endif
+        }
+        if (!reported && first_pixel_ms >= 0) {
+            pc.printf("boot to first pixel: %d ms\r\n", first_pixel_ms);
+            reported = true;
+        }
+        eventQueue.dispatch(sleep_ms);  /* runs panel and BLE events meanwhile */
     }
 
     for (;;) {